@@ -83,4 +83,5 @@ void WorldUtilityStats::finish()
 	else {
 		recordScalar("Usage", bitsReceived / simTime());
 	}
+	BaseWorldUtility::finish();
 }
@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+#
+# Converts a binary trace file written by TraceChannel (e.g. the pulse
+# traces of UWBIRMac and DeciderUWBIRED with binaryTrace enabled) to CSV
+# lines "channel,time,value" on stdout.
+#
+# usage: traceToCsv.py results/General-0-pulses.trace [channel substring]
+#
+import struct
+import sys
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = ord(data[pos:pos + 1])
+        pos += 1
+        value |= (byte & 0x7f) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def read_trace(fileName):
+    data = open(fileName, 'rb').read()
+    if data[0:4] != b'MXTR' or ord(data[4:5]) != 1:
+        raise ValueError('%s is no trace file' % fileName)
+    scaleExp = struct.unpack('b', data[5:6])[0]
+    scale = 10.0 ** scaleExp
+    channels = {}
+    pos = 6
+    while pos < len(data):
+        tag = data[pos:pos + 1]
+        pos += 1
+        channelId, pos = read_varint(data, pos)
+        length, pos = read_varint(data, pos)
+        if tag == b'C':
+            channels[channelId] = data[pos:pos + length].decode('utf-8')
+            pos += length
+        elif tag == b'B':
+            times = []
+            last = 0
+            for i in range(length):
+                delta, pos = read_varint(data, pos)
+                last += unzigzag(delta)
+                times.append(last * scale)
+            values = struct.unpack('<%dd' % length, data[pos:pos + 8 * length])
+            pos += 8 * length
+            yield channels.get(channelId, str(channelId)), times, values
+        else:
+            raise ValueError('unknown record at offset %d' % (pos - 1))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.exit('usage: %s <trace file> [channel substring]' % sys.argv[0])
+    wanted = sys.argv[2] if len(sys.argv) > 2 else ''
+    for channel, times, values in read_trace(sys.argv[1]):
+        if wanted in channel:
+            for t, v in zip(times, values):
+                sys.stdout.write('%s,%.12g,%.12g\n' % (channel, t, v))
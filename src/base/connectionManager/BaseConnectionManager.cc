@@ -1,6 +1,10 @@
 #include "BaseConnectionManager.h"
 
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
 
 #include "NicEntryDebug.h"
 #include "NicEntryDirect.h"
@@ -27,7 +31,18 @@ BaseConnectionManager::BaseConnectionManager()
   , nicGrid()
   , findDistance()
   , gridDim()
-{}
+  , batchRangeCheck(false)
+  , rangeCandidates()
+  , candidatePositions()
+  , candidateSqrDistances()
+  , kineticConnections(false)
+  , kineticNics()
+  , kineticEvents()
+  , kineticCompactSize(1024)
+  , kineticTimer(NULL)
+{
+	GlobalModuleRegistry::add(this);
+}
 
 void BaseConnectionManager::initialize(int stage)
 {
@@ -58,6 +73,20 @@ void BaseConnectionManager::initialize(int stage)
 		else
 			sendDirect = false;
 
+		batchRangeCheck = hasPar("batchRangeCheck")
+								? par("batchRangeCheck").boolValue() : false;
+
+		kineticConnections = hasPar("kineticConnections")
+								? par("kineticConnections").boolValue() : false;
+		if(kineticConnections) {
+			if(useTorus)
+				error("kineticConnections is not supported on a torus playground.");
+			if(!supportsKineticConnections())
+				error("kineticConnections is not supported by %s, it decides the"
+				      " connections with updateConnections() or isInRange().", getClassName());
+			kineticTimer = new cMessage("kineticConnections");
+		}
+
 		maxInterferenceDistance = calcInterfDist();
 		maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
 
@@ -167,7 +196,7 @@ void BaseConnectionManager::registerNicExt(NicEntry::t_nicid_cref nicID)
 {
 	NicEntries::mapped_type nicEntry = nics[nicID];
 
-	GridCoord cell = getCellForCoordinate(nicEntry->pos);
+	GridCoord cell = getCellForCoordinate(nicEntry->pos.toCoord());
 
 	ccEV <<" registering (ext) nic at loc " << cell.info() << std::endl;
 
@@ -264,7 +293,7 @@ bool BaseConnectionManager::isInRange(BaseConnectionManager::NicEntries::mapped_
 	double dDistance = 0.0;
 
     if(useTorus) {
-    	dDistance = pFromNic->pos.sqrTorusDist(pToNic->pos, *playgroundSize);
+    	dDistance = pFromNic->pos.sqrTorusDist(pToNic->pos, PlainCoord(*playgroundSize));
     } else {
     	dDistance = pFromNic->pos.sqrdist(pToNic->pos);
     }
@@ -275,37 +304,66 @@ void BaseConnectionManager::updateNicConnections(NicEntries& nmap, BaseConnectio
 {
     NicEntry::t_nicid_cref id = nic->nicId;
 
+    if (batchRangeCheck) {
+        // gather the positions of the cell and compute all distances in one pass
+        rangeCandidates.clear();
+        candidatePositions.clear();
+        for(NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
+            // no recursive connections
+            if ( i->second->nicId == id ) continue;
+            rangeCandidates.push_back(i->second);
+            candidatePositions.push_back(i->second->pos);
+        }
+        candidateSqrDistances.resize(rangeCandidates.size());
+        if (rangeCandidates.empty())
+            return;
+        if (useTorus)
+            candidatePositions.sqrTorusDistances(nic->pos, PlainCoord(*playgroundSize), &candidateSqrDistances[0]);
+        else
+            candidatePositions.sqrDistances(nic->pos, &candidateSqrDistances[0]);
+
+        for(size_t i = 0; i < rangeCandidates.size(); ++i) {
+            updateNicConnection(nic, rangeCandidates[i], candidateSqrDistances[i] <= maxDistSquared);
+        }
+        return;
+    }
+
     for(NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
     	NicEntries::mapped_type nic_i = i->second;
 
         // no recursive connections
         if ( nic_i->nicId == id ) continue;
 
-        bool inRange   = isInRange(nic, nic_i);
-        bool connected = nic->isConnected(nic_i);
+        updateNicConnection(nic, nic_i, isInRange(nic, nic_i));
+    }
+}
 
-        if ( inRange && !connected ) {
-            // nodes within communication range: connect
-            // nodes within communication range && not yet connected
-            ccEV << "nic #" << id << " and #" << nic_i->nicId
-            	 << " are in range" << endl;
-            nic->connectTo( nic_i );
-            nic_i->connectTo( nic );
-        }
-        else if ( !inRange && connected ) {
-            // out of range: disconnect
-            // out of range, and still connected
-            ccEV << "nic #" << id << " and #" << nic_i->nicId
-            	 << " are NOT in range" << endl;
-            nic->disconnectFrom( nic_i );
-            nic_i->disconnectFrom( nic );
-        }
+void BaseConnectionManager::updateNicConnection(NicEntries::mapped_type nic, NicEntries::mapped_type nic_i, bool inRange)
+{
+    bool connected = nic->isConnected(nic_i);
+
+    if ( inRange && !connected ) {
+        // nodes within communication range: connect
+        // nodes within communication range && not yet connected
+        ccEV << "nic #" << nic->nicId << " and #" << nic_i->nicId
+             << " are in range" << endl;
+        nic->connectTo( nic_i );
+        nic_i->connectTo( nic );
+    }
+    else if ( !inRange && connected ) {
+        // out of range: disconnect
+        // out of range, and still connected
+        ccEV << "nic #" << nic->nicId << " and #" << nic_i->nicId
+             << " are NOT in range" << endl;
+        nic->disconnectFrom( nic_i );
+        nic_i->disconnectFrom( nic );
     }
 }
 
 bool BaseConnectionManager::registerNic(cModule*                 nic,
                                         ConnectionManagerAccess* chAccess,
-                                        const Coord*             nicPos)
+                                        const Coord*             nicPos,
+                                        const Coord*             nicSpeed)
 {
 	assert(nic != NULL);
 
@@ -333,7 +391,18 @@ bool BaseConnectionManager::registerNic(cModule*                 nic,
 
 	registerNicExt(nicID);
 
-	updateConnections(nicID, nicPos, nicPos);
+	if(kineticConnections) {
+		Enter_Method_Silent();
+		KineticNic& kNic = kineticNics[nicID];
+		kNic.speed = nicSpeed ? PlainCoord(*nicSpeed) : PlainCoord();
+		kNic.since = simTime();
+		kNic.cell  = getCellForCoordinate(*nicPos);
+		replanKineticNic(nicEntry, kNic);
+		rescheduleKineticTimer();
+		kineticConnectionsUpdated();
+	} else {
+		updateConnections(nicID, nicPos, nicPos);
+	}
 
 	if(drawMIR && pHostModule) {
 		cDisplayString& Displ = pHostModule->getDisplayString();
@@ -362,7 +431,9 @@ bool BaseConnectionManager::unregisterNic(cModule* nicModule)
 
 	// get all affected grid squares
 	CoordSet gridUnion(74);
-	GridCoord cell = getCellForCoordinate(nicEntry->pos);
+	KineticNics::iterator kNicIt = kineticNics.find(nicID);
+	GridCoord cell = (kNicIt != kineticNics.end())
+						? kNicIt->second.cell : getCellForCoordinate(nicEntry->pos.toCoord());
 	if((gridDim.x == 1) && (gridDim.y == 1) && (gridDim.z == 1)) {
 		gridUnion.add(cell);
 	} else {
@@ -394,6 +465,10 @@ bool BaseConnectionManager::unregisterNic(cModule* nicModule)
 
 	unregisterNicExt(nicID);
 
+	// pending kinetic events of the nic are dropped when they are due
+	if(kNicIt != kineticNics.end())
+		kineticNics.erase(kNicIt);
+
 	// erase from list of known nics
 	nics.erase(nicEntryIt);
 	delete nicEntry;
@@ -406,14 +481,39 @@ void BaseConnectionManager::unregisterNicExt(NicEntry::t_nicid_cref nicID)
 	(void)nicID;
 }
 
-void BaseConnectionManager::updateNicPos(NicEntry::t_nicid_cref nicID, const Coord* newPos)
+void BaseConnectionManager::updateNicPos(NicEntry::t_nicid_cref nicID, const Coord* newPos, const Coord* newSpeed)
 {
 	NicEntries::iterator ItNic = nics.find(nicID);
 	if (ItNic == nics.end()) {
 		opp_warning("No nic with this ID (%d) is registered with this ConnectionManager, no position update done.", nicID);
 		return;
 	}
-	Coord oldPos = ItNic->second->pos;
+	if (kineticConnections) {
+		Enter_Method_Silent();
+		KineticNic&       kNic  = kineticNics[nicID];
+		const simtime_t   now   = simTime();
+		const PlainCoord  pos(*newPos);
+		const PlainCoord  speed = newSpeed ? PlainCoord(*newSpeed) : PlainCoord();
+
+		// still on the known trajectory: the connection events are already planned
+		if (speed.sqrdist(kNic.speed) <= EPSILON * EPSILON
+		    && pos.sqrdist(getKineticPosition(ItNic->second, kNic, now)) <= EPSILON * EPSILON) {
+			kineticConnectionsUpdated();
+			return;
+		}
+
+		ItNic->second->pos = pos;
+		kNic.speed = speed;
+		kNic.since = now;
+		const GridCoord cell = getCellForCoordinate(*newPos);
+		if (cell != kNic.cell)
+			moveKineticNic(ItNic->second, kNic, cell);
+		replanKineticNic(ItNic->second, kNic);
+		rescheduleKineticTimer();
+		kineticConnectionsUpdated();
+		return;
+	}
+	Coord oldPos = ItNic->second->pos.toCoord();
 	ItNic->second->pos = *newPos;
 
 	updateConnections(nicID, &oldPos, newPos);
@@ -444,7 +544,259 @@ const cGate* BaseConnectionManager::getOutGateTo(const NicEntry* nic,
 
 BaseConnectionManager::~BaseConnectionManager()
 {
+	GlobalModuleRegistry::remove(this);
+	cancelAndDelete(kineticTimer);
 	for (NicEntries::iterator ne = nics.begin(); ne != nics.end(); ++ne) {
 		delete ne->second;
 	}
 }
+
+void BaseConnectionManager::handleMessage(cMessage* msg)
+{
+	if (msg != kineticTimer)
+		error("Unexpected message %s.", msg->getName());
+
+	std::greater<KineticEvent> later;
+	while (!kineticEvents.empty() && kineticEvents.front().time <= simTime()) {
+		std::pop_heap(kineticEvents.begin(), kineticEvents.end(), later);
+		const KineticEvent event = kineticEvents.back();
+		kineticEvents.pop_back();
+		handleKineticEvent(event);
+	}
+	rescheduleKineticTimer();
+	kineticConnectionsUpdated();
+}
+
+Coord BaseConnectionManager::getCurrentNicPos(const NicEntry* nic) const
+{
+	KineticNics::const_iterator kNic = kineticNics.find(nic->nicId);
+	if (kNic == kineticNics.end())
+		return nic->pos.toCoord();
+	return getKineticPosition(nic, kNic->second, simTime()).toCoord();
+}
+
+PlainCoord BaseConnectionManager::getKineticPosition(const NicEntry* nic, const KineticNic& kNic, simtime_t_cref t) const
+{
+	const double dt = (t - kNic.since).dbl();
+	return PlainCoord(nic->pos.x + kNic.speed.x * dt,
+	                  nic->pos.y + kNic.speed.y * dt,
+	                  nic->pos.z + kNic.speed.z * dt);
+}
+
+void BaseConnectionManager::moveKineticNic(NicEntries::mapped_type nic, KineticNic& kNic, const GridCoord& cell)
+{
+	getCellEntries(kNic.cell).erase(nic->nicId);
+	getCellEntries(cell)[nic->nicId] = nic;
+	kNic.cell = cell;
+}
+
+void BaseConnectionManager::replanKineticNic(NicEntries::mapped_type nic, KineticNic& kNic)
+{
+	assert(kNic.since == simTime());
+	++kNic.version;
+
+	CoordSet gridUnion(74);
+	if((gridDim.x == 1) && (gridDim.y == 1) && (gridDim.z == 1)) {
+		gridUnion.add(kNic.cell);
+	} else {
+		fillUnionWithNeighbors(gridUnion, kNic.cell);
+	}
+
+	GridCoord* c = gridUnion.next();
+	while(c != 0) {
+		NicEntries& nmap = getCellEntries(*c);
+		for(NicEntries::iterator i = nmap.begin(); i != nmap.end(); ++i) {
+			if (i->first == nic->nicId)
+				continue;
+			KineticNics::const_iterator kOther = kineticNics.find(i->first);
+			assert(kOther != kineticNics.end());
+			planKineticPair(nic, kNic, i->second, kOther->second);
+		}
+		c = gridUnion.next();
+	}
+
+	// nics outside of the neighbor cells are out of range, but could still
+	// be connected if their disconnect event is due at the same time
+	std::vector<NicEntry::t_nicid> peers;
+	const NicEntry::GateList& gates = nic->getGateList();
+	for(NicEntry::GateList::const_iterator it = gates.begin(); it != gates.end(); ++it) {
+		peers.push_back(it->first->nicId);
+	}
+	for(size_t i = 0; i < peers.size(); ++i) {
+		NicEntries::mapped_type     other  = nics.find(peers[i])->second;
+		KineticNics::const_iterator kOther = kineticNics.find(peers[i]);
+		if (getKineticPosition(other, kOther->second, kNic.since).sqrdist(nic->pos) > maxDistSquared)
+			updateNicConnection(nic, other, false);
+	}
+
+	planKineticCellChange(nic, kNic);
+}
+
+void BaseConnectionManager::planKineticPair(NicEntries::mapped_type nic, const KineticNic& kNic,
+                                            NicEntries::mapped_type other, const KineticNic& kOther)
+{
+	const simtime_t  now = kNic.since;
+	const PlainCoord d   = getKineticPosition(other, kOther, now);
+	const double     dx  = d.x - nic->pos.x;
+	const double     dy  = d.y - nic->pos.y;
+	const double     dz  = d.z - nic->pos.z;
+	const double     vx  = kOther.speed.x - kNic.speed.x;
+	const double     vy  = kOther.speed.y - kNic.speed.y;
+	const double     vz  = kOther.speed.z - kNic.speed.z;
+
+	// |d + v*t|^2 = maxDistSquared  <=>  a*t^2 + b*t + c = 0
+	const double a         = vx * vx + vy * vy + vz * vz;
+	const double b         = 2 * (dx * vx + dy * vy + dz * vz);
+	const double c         = dx * dx + dy * dy + dz * dz - maxDistSquared;
+	const bool   connected = (c <= 0);
+
+	updateNicConnection(nic, other, connected);
+
+	const double disc = b * b - 4 * a * c;
+	if (a == 0 || disc < 0)
+		// constant distance, or the nics never come into range
+		return;
+
+	const double root    = sqrt(disc);
+	const double enter   = (-b - root) / (2 * a);
+	const double leave   = (-b + root) / (2 * a);
+	// events beyond the end of the simulation time range are never due
+	const double horizon = (MAXTIME - now).dbl();
+
+	KineticEvent event;
+	event.nic          = nic->nicId;
+	event.nicVersion   = kNic.version;
+	event.other        = other->nicId;
+	event.otherVersion = kOther.version;
+	if (connected) {
+		if (leave >= horizon)
+			return;
+		event.type = KineticEvent::DISCONNECT;
+		event.time = now + std::max(leave, 0.0);
+	} else {
+		if (enter <= 0 || enter >= horizon)
+			return;
+		event.type      = KineticEvent::CONNECT;
+		event.time      = now + enter;
+		event.leaveTime = (leave < horizon) ? now + leave : MAXTIME;
+	}
+	pushKineticEvent(event);
+}
+
+void BaseConnectionManager::planKineticCellChange(NicEntries::mapped_type nic, const KineticNic& kNic)
+{
+	const double pos[3]   = { nic->pos.x, nic->pos.y, nic->pos.z };
+	const double speed[3] = { kNic.speed.x, kNic.speed.y, kNic.speed.z };
+	const double size[3]  = { findDistance.x, findDistance.y, findDistance.z };
+	const int    cell[3]  = { kNic.cell.x, kNic.cell.y, kNic.cell.z };
+	const int    dim[3]   = { gridDim.x, gridDim.y, gridDim.z };
+
+	KineticEvent event;
+	double       first = std::numeric_limits<double>::infinity();
+	for (int axis = 0; axis < 3; ++axis) {
+		if (speed[axis] == 0)
+			continue;
+		const int step = (speed[axis] > 0) ? 1 : -1;
+		if (cell[axis] + step < 0 || cell[axis] + step >= dim[axis])
+			// leaves the playground, it stays in the border cell
+			continue;
+		const double border = (step > 0 ? cell[axis] + 1 : cell[axis]) * size[axis];
+		const double offset = std::max((border - pos[axis]) / speed[axis], 0.0);
+		if (offset < first) {
+			first      = offset;
+			event.axis = axis;
+			event.step = step;
+		}
+	}
+	if (first >= (MAXTIME - kNic.since).dbl())
+		return;
+
+	event.type       = KineticEvent::CELL_CHANGE;
+	event.time       = kNic.since + first;
+	event.nic        = nic->nicId;
+	event.nicVersion = kNic.version;
+	pushKineticEvent(event);
+}
+
+bool BaseConnectionManager::isKineticEventValid(const KineticEvent& event) const
+{
+	KineticNics::const_iterator kNic = kineticNics.find(event.nic);
+	if (kNic == kineticNics.end() || kNic->second.version != event.nicVersion)
+		return false;
+	if (event.type == KineticEvent::CELL_CHANGE)
+		return true;
+	KineticNics::const_iterator kOther = kineticNics.find(event.other);
+	return kOther != kineticNics.end() && kOther->second.version == event.otherVersion;
+}
+
+void BaseConnectionManager::pushKineticEvent(const KineticEvent& event)
+{
+	std::greater<KineticEvent> later;
+
+	kineticEvents.push_back(event);
+	std::push_heap(kineticEvents.begin(), kineticEvents.end(), later);
+
+	if (kineticEvents.size() > kineticCompactSize) {
+		// drop the events of replanned nics, they would only be dropped when due
+		size_t valid = 0;
+		for (size_t i = 0; i < kineticEvents.size(); ++i) {
+			if (isKineticEventValid(kineticEvents[i]))
+				kineticEvents[valid++] = kineticEvents[i];
+		}
+		kineticEvents.resize(valid);
+		std::make_heap(kineticEvents.begin(), kineticEvents.end(), later);
+		kineticCompactSize = std::max<size_t>(1024, 2 * valid);
+	}
+}
+
+void BaseConnectionManager::handleKineticEvent(const KineticEvent& event)
+{
+	if (!isKineticEventValid(event))
+		return;
+
+	NicEntries::mapped_type nic  = nics.find(event.nic)->second;
+	KineticNic&             kNic = kineticNics.find(event.nic)->second;
+
+	if (event.type == KineticEvent::CELL_CHANGE) {
+		GridCoord cell(kNic.cell);
+		switch (event.axis) {
+			case 0: cell.x += event.step; break;
+			case 1: cell.y += event.step; break;
+			default: cell.z += event.step; break;
+		}
+		ccEV << "nic #" << nic->nicId << " moves to cell " << cell.info() << endl;
+		nic->pos   = getKineticPosition(nic, kNic, event.time);
+		kNic.since = event.time;
+		moveKineticNic(nic, kNic, cell);
+		replanKineticNic(nic, kNic);
+		return;
+	}
+
+	NicEntries::mapped_type other = nics.find(event.other)->second;
+	if (event.type == KineticEvent::CONNECT) {
+		updateNicConnection(nic, other, true);
+		if (event.leaveTime < MAXTIME) {
+			KineticEvent leave(event);
+			leave.type = KineticEvent::DISCONNECT;
+			leave.time = event.leaveTime;
+			pushKineticEvent(leave);
+		}
+	} else {
+		updateNicConnection(nic, other, false);
+	}
+}
+
+void BaseConnectionManager::rescheduleKineticTimer()
+{
+	if (kineticEvents.empty()) {
+		cancelEvent(kineticTimer);
+		return;
+	}
+	const simtime_t next = kineticEvents.front().time;
+	if (kineticTimer->isScheduled()) {
+		if (kineticTimer->getArrivalTime() == next)
+			return;
+		cancelEvent(kineticTimer);
+	}
+	scheduleAt(next, kineticTimer);
+}
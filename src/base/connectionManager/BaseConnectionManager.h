@@ -195,6 +195,57 @@ private:
 		unsigned getmaxSize() const { return maxSize; }
 	};
 
+	/**
+	 * @brief Linear trajectory and grid cell of a nic in kinetic mode.
+	 *
+	 * The nic is at NicEntry::pos at time "since" and moves with "speed".
+	 */
+	struct KineticNic {
+		PlainCoord    speed;
+		simtime_t     since;
+		GridCoord     cell;
+		/** @brief Incremented on each replanning, outdates the pending events of the nic.*/
+		unsigned long version;
+
+		KineticNic(): speed(), since(), cell(), version(0) {}
+	};
+
+	/** @brief Precomputed change of a connection or of the grid cell of a nic.*/
+	struct KineticEvent {
+		enum Type {
+			CONNECT,
+			DISCONNECT,
+			CELL_CHANGE
+		};
+
+		simtime_t         time;
+		int               type;
+		NicEntry::t_nicid nic;
+		unsigned long     nicVersion;
+		/** @name Other nic of a connection event.*/
+		/*@{*/
+		NicEntry::t_nicid other;
+		unsigned long     otherVersion;
+		/*@}*/
+		/** @brief Time the nics leave the range again after a CONNECT (MAXTIME if never).*/
+		simtime_t         leaveTime;
+		/** @name Axis (0..2) and direction (+1/-1) of a CELL_CHANGE.*/
+		/*@{*/
+		int               axis;
+		int               step;
+		/*@}*/
+
+		KineticEvent()
+			: time(), type(CONNECT), nic(0), nicVersion(0), other(0), otherVersion(0)
+			, leaveTime(), axis(0), step(0) {}
+
+		/** @brief Orders the event heap by time.*/
+		bool operator>(const KineticEvent& o) const { return time > o.time; }
+	};
+
+	/** @brief Type for map from nic-module id to its kinetic state.*/
+	typedef std::map<NicEntry::t_nicid, KineticNic> KineticNics;
+
 protected:
 	/** @brief Type for map from nic-module id to nic-module pointer.*/
 	typedef std::map<NicEntry::t_nicid, NicEntry*> NicEntries;
@@ -253,10 +304,91 @@ protected:
     /** @brief The size of the grid */
     GridCoord gridDim;
 
+    /**
+     * @brief If true, updateNicConnections() computes the distances of all
+     * nics of a grid cell with one batch kernel instead of calling
+     * isInRange() for each of them.
+     *
+     * Set by the parameter "batchRangeCheck" (default false). It bypasses
+     * isInRange(), so it must not be enabled for subclasses which override
+     * isInRange().
+     */
+    bool batchRangeCheck;
+
+    /** @name Reused buffers of the batch range check.*/
+    /*@{*/
+    std::vector<NicEntries::mapped_type> rangeCandidates;
+    CoordBatch                           candidatePositions;
+    std::vector<double>                  candidateSqrDistances;
+    /*@}*/
+
+    /**
+     * @brief If true, connections are updated kinetically instead of on
+     * every position update.
+     *
+     * The position and speed reported by the mobility module define a linear
+     * trajectory per nic. From these, the times at which two nics enter or
+     * leave the interference range and at which a nic changes its grid cell
+     * are computed in advance and handled by a self message. Position updates
+     * which stay on the known trajectory are ignored; a changed speed or
+     * position only replans the pairs of the updated nic.
+     *
+     * Like batchRangeCheck, this only uses maxDistSquared; it is rejected
+     * for connection managers whose supportsKineticConnections() returns
+     * false, which get kineticConnectionsUpdated() called instead of
+     * updateConnections(). Not supported on a torus playground.
+     */
+    bool kineticConnections;
+
 private:
+    /** @name State of the kinetic mode.*/
+    /*@{*/
+    KineticNics               kineticNics;
+    /** @brief Heap of the pending events, ordered by std::greater.*/
+    std::vector<KineticEvent> kineticEvents;
+    /** @brief Heap size which triggers removing outdated events.*/
+    size_t                    kineticCompactSize;
+    /** @brief Scheduled at the time of the earliest pending event.*/
+    cMessage*                 kineticTimer;
+    /*@}*/
+
+	/** @brief Returns the position of a kinetic nic at time "t".*/
+	PlainCoord getKineticPosition(const NicEntry* nic, const KineticNic& kNic, simtime_t_cref t) const;
+
+	/** @brief Moves a kinetic nic to another grid cell.*/
+	void moveKineticNic(NicEntries::mapped_type nic, KineticNic& kNic, const GridCoord& cell);
+
+	/**
+	 * @brief Recomputes the events of a kinetic nic after its trajectory or
+	 * grid cell changed; kNic.since has to be the current time.
+	 */
+	void replanKineticNic(NicEntries::mapped_type nic, KineticNic& kNic);
+
+	/** @brief Sets the connection of two kinetic nics and schedules its next change.*/
+	void planKineticPair(NicEntries::mapped_type nic, const KineticNic& kNic,
+	                     NicEntries::mapped_type other, const KineticNic& kOther);
+
+	/** @brief Schedules the time a kinetic nic leaves its grid cell.*/
+	void planKineticCellChange(NicEntries::mapped_type nic, const KineticNic& kNic);
+
+	/** @brief Returns false if the nics of the event were replanned or unregistered.*/
+	bool isKineticEventValid(const KineticEvent& event) const;
+
+	/** @brief Adds an event to the heap, drops outdated events if the heap has grown.*/
+	void pushKineticEvent(const KineticEvent& event);
+
+	/** @brief Applies an event which is due now.*/
+	void handleKineticEvent(const KineticEvent& event);
+
+	/** @brief Schedules the kinetic timer at the earliest pending event.*/
+	void rescheduleKineticTimer();
+
 	/** @brief Manages the connections of a registered nic. */
     void updateNicConnections(NicEntries& nmap, NicEntries::mapped_type nic);
 
+    /** @brief Connects or disconnects two nics according to the result of the range check. */
+    void updateNicConnection(NicEntries::mapped_type nic, NicEntries::mapped_type nic_i, bool inRange);
+
     /**
      * @brief Check connections of a nic in the grid
      */
@@ -345,7 +477,8 @@ protected:
 	 * @brief Check if the two nic's are in range.
 	 *
 	 * This function will be used to decide if two nic's shall be connected or not. It
-	 * is simple to overload this function to enhance the decision for connection or not.
+	 * is simple to overload this function to enhance the decision for connection or not
+	 * (batchRangeCheck must not be enabled then).
 	 *
 	 * @param pFromNic Nic source point which should be checked.
 	 * @param pToNic   Nic target point which should be checked.
@@ -353,6 +486,36 @@ protected:
 	 */
 	virtual bool isInRange(NicEntries::mapped_type pFromNic, NicEntries::mapped_type pToNic);
 
+	/**
+	 * @brief Returns true if this connection manager can run with
+	 * kineticConnections enabled.
+	 *
+	 * Kinetic mode neither calls "updateConnections()" nor "isInRange()",
+	 * it connects two nics iff their distance is at most
+	 * maxInterferenceDistance. "initialize()" raises an error if
+	 * kineticConnections is set but this method returns false.
+	 * ConnectionManager returns true; its subclasses which override
+	 * "updateConnections()" or "isInRange()" have to return false again.
+	 */
+	virtual bool supportsKineticConnections() const { return false; }
+
+	/**
+	 * @brief Called in kinetic mode instead of "updateConnections()".
+	 *
+	 * Called after every position update of a nic and after every handled
+	 * kinetic event, when the connections of all nics are up to date.
+	 * Use "getCurrentNicPos()" to get the position of a nic at this time.
+	 */
+	virtual void kineticConnectionsUpdated() {}
+
+	/**
+	 * @brief Returns the position of the nic at the current simulation time.
+	 *
+	 * In kinetic mode NicEntry::pos is only updated when the trajectory of
+	 * the nic changes, the current position is extrapolated from it.
+	 */
+	Coord getCurrentNicPos(const NicEntry* nic) const;
+
 private:
 	/** @brief Copy constructor is not allowed.
 	 */
@@ -376,13 +539,19 @@ public:
 	 **/
 	virtual void initialize(int stage);
 
+	/** @brief Handles the timer of the kinetic connection updates.*/
+	virtual void handleMessage(cMessage* msg);
+
 	/**
 	 * @brief Registers a nic to have its connections managed by ConnectionManager.
 	 *
 	 * If you want to do your own stuff at the registration of a nic see
 	 * "registerNicExt()".
+	 *
+	 * The speed is only used by kinetic connection updates, NULL means a
+	 * stationary nic.
 	 */
-        bool registerNic(cModule* nic, ConnectionManagerAccess* chAccess, const Coord* nicPos);
+        bool registerNic(cModule* nic, ConnectionManagerAccess* chAccess, const Coord* nicPos, const Coord* nicSpeed = NULL);
 
 	/**
 	 * @brief Unregisters a NIC such that its connections aren't managed by the CM
@@ -398,8 +567,13 @@ public:
 	 */
 	bool unregisterNic(cModule* nic);
 
-	/** @brief Updates the position information of a registered nic.*/
-	void updateNicPos(NicEntry::t_nicid_cref nicID, const Coord* newPos);
+	/**
+	 * @brief Updates the position information of a registered nic.
+	 *
+	 * The speed is only used by kinetic connection updates, NULL means a
+	 * stationary nic.
+	 */
+	void updateNicPos(NicEntry::t_nicid_cref nicID, const Coord* newPos, const Coord* newSpeed = NULL);
 
 	/** @brief Returns the ingates of all nics in range*/
 	const NicEntry::GateList& getGateList(NicEntry::t_nicid_cref nicID) const;
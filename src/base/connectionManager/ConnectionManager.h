@@ -29,6 +29,9 @@ class MIXIM_API ConnectionManager : public BaseConnectionManager
          * interference calculation
          */
         virtual double calcInterfDist();
+
+        /** @brief Connections only depend on maxInterferenceDistance.*/
+        virtual bool supportsKineticConnections() const { return true; }
 };
 
 #endif /*CONNECTIONMANAGER_H_*/
@@ -147,7 +147,7 @@ simtime_t ConnectionManagerAccess::calculatePropagationDelay(const NicEntry* nic
 	Coord           receiverPos = receiverModule->getMobilityModule()->getCurrentPosition(/*sStart*/);
 
 	// this time-point is used to calculate the distance between sending and receiving host
-	return receiverPos.distance(sendersPos) / BaseWorldUtility::speedOfLight;
+	return PlainCoord(receiverPos).distance(sendersPos) / BaseWorldUtility::speedOfLight;
 }
 
 void ConnectionManagerAccess::receiveSignal(cComponent */*source*/, simsignal_t signalID, cObject *obj)
@@ -155,14 +155,15 @@ void ConnectionManagerAccess::receiveSignal(cComponent */*source*/, simsignal_t
     if(signalID == mobilityStateChangedSignal) {
     	ChannelMobilityPtrType const mobility = check_and_cast<ChannelMobilityPtrType>(obj);
         Coord                        pos      = mobility->getCurrentPosition();
+        Coord                        speed    = mobility->getCurrentSpeed();
 
         if(isRegistered) {
-            cc->updateNicPos(getNic()->getId(), &pos);
+            cc->updateNicPos(getNic()->getId(), &pos, &speed);
         }
         else {
             // register the nic with ConnectionManager
             // returns true, if sendDirect is used
-            useSendDirect = cc->registerNic(getNic(), this, &pos);
+            useSendDirect = cc->registerNic(getNic(), this, &pos, &speed);
             isRegistered  = true;
         }
     }
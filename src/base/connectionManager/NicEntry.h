@@ -26,7 +26,7 @@
 #include <map>
 
 #include "MiXiMDefs.h"
-#include "Coord.h"
+#include "PlainCoord.h"
 
 class ConnectionManagerAccess;
 
@@ -66,7 +66,7 @@ class MIXIM_API NicEntry : public cObject
     int hostId;
 
     /** @brief Geographic location of the nic*/
-    Coord pos;
+    PlainCoord pos;
 
     /** @brief Points to this nics ConnectionManagerAccess module */
     ConnectionManagerAccess* chAccess;
@@ -282,7 +282,11 @@ ConstMapping* BaseMacLayer::createSingleFrequencyMapping(simtime_t_cref
                                                          Argument::mapped_type_cref halfBandwidth,
                                                          Argument::mapped_type_cref value)
 {
-    Mapping* res = MappingUtils::createMapping(Argument::MappedZero, DimensionSet::timeFreqDomain, Mapping::LINEAR);
+    TimeFreqGridMapping::FreqAxis freqs;
+    freqs.push_back(centerFreq - halfBandwidth);
+    freqs.push_back(centerFreq + halfBandwidth);
+
+    Mapping* res = new TimeFreqGridMapping(freqs, Argument::MappedZero);
 
     Argument pos(DimensionSet::timeFreqDomain);
 
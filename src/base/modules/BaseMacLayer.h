@@ -204,6 +204,9 @@ protected:
     /**
      * @brief Creates a Mapping defined over time and frequency with
      * constant power in a certain frequency band.
+     *
+     * The result is a dense TimeFreqGridMapping, so combining it with other
+     * signals and attenuations works directly on its rows.
      */
     ConstMapping* createSingleFrequencyMapping(simtime_t_cref start, simtime_t_cref end, Argument::mapped_type_cref centerFreq, Argument::mapped_type_cref bandWith, Argument::mapped_type_cref value);
 
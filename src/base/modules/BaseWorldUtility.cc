@@ -19,8 +19,12 @@
  **************************************************************************/
 
 #include "BaseWorldUtility.h"
+
+#include <sstream>
+
 #include "FindModule.h"
 #include "BaseConnectionManager.h"
+#include "BasePhyLayer.h"
 
 Define_Module(BaseWorldUtility);
 
@@ -33,7 +37,16 @@ BaseWorldUtility::BaseWorldUtility()
 	, use2DFlag(false)
 	, airFrameId(0)
 	, isInitialized(false)
-{}
+{
+	GlobalModuleRegistry::add(this);
+}
+
+BaseWorldUtility::~BaseWorldUtility()
+{
+	GlobalModuleRegistry::remove(this);
+	// the cached XML parameters belong to the network which is deleted now
+	BasePhyLayer::clearXMLParameterCache();
+}
 
 void BaseWorldUtility::initialize(int stage) {
 	if (stage == 0) {
@@ -48,6 +61,14 @@ void BaseWorldUtility::initialize(int stage) {
 	}
 }
 
+void BaseWorldUtility::finish()
+{
+	// startup profile: which global module lookups still searched the module tree
+	std::ostringstream profile;
+	GlobalModuleRegistry::printProfile(profile);
+	EV << profile.str();
+}
+
 void BaseWorldUtility::initializeIfNecessary()
 {
 	if(isInitialized)
@@ -68,9 +68,12 @@ protected:
 
 public:
     BaseWorldUtility();
+    virtual ~BaseWorldUtility();
 
     virtual void initialize(int stage);
 
+    virtual void finish();
+
     /**
      * @brief Returns the playgroundSize
      *
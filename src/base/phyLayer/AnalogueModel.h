@@ -54,6 +54,12 @@ public:
 	 * @param receiverPos	The position of frame receiver.
 	 */
 	virtual void filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos) = 0;
+
+	/**
+	 * @brief Called by the physical layer during its own finish(), to let
+	 * the model record its statistics.
+	 */
+	virtual void finish() {}
 };
 
 #endif /*ANALOGUEMODEL_*/
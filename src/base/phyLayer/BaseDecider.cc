@@ -232,6 +232,7 @@ simtime_t BaseDecider::handleChannelSenseRequest(ChannelSenseRequest* request)
 
 	if(now >= currentChannelSenseRequest.getAnswerTime()) {
 	    simtime_t canAnswerAt = canAnswerCSR(currentChannelSenseRequest);
+	    storeSenseEdge();
 
 	    if (canAnswerAt > now) {
 	        currentChannelSenseRequest.setAnswerTime( canAnswerAt );
@@ -255,6 +256,7 @@ simtime_t BaseDecider::handleNewSenseRequest(ChannelSenseRequest* request)
 	//get point in time when we can answer the request (as far as we
 	//know at this point in time)
 	currentChannelSenseRequest.setAnswerTime( canAnswerCSR(currentChannelSenseRequest) );
+	storeSenseEdge();
 
 	//check if we can already answer the request
 	if(now >= currentChannelSenseRequest.getAnswerTime()) {
@@ -326,8 +328,16 @@ void BaseDecider::channelStateChanged()
 	if(!currentChannelSenseRequest.getRequest())
 		return;
 
+	//the answer time only changes with the busy/idle edge of the channel
+	if(!senseEdgeChanged()) {
+		++nbSenseRecomputationsAvoided;
+		return;
+	}
+	++nbSenseRecomputations;
+
 	//check if the point in time when we can answer the request has changed
 	simtime_t canAnswerAt = canAnswerCSR(currentChannelSenseRequest);
+	storeSenseEdge();
 
 	//check if answer time has changed
 	if(canAnswerAt != currentChannelSenseRequest.getAnswerTime()) {
@@ -541,6 +551,8 @@ void BaseDecider::finish()
         phy->recordScalar("nbFramesWithoutInterferencePartial", nbFramesWithoutInterferencePartial);
         phy->recordScalar("nbFramesWithInterferenceDropped"   , nbFramesWithInterferenceDropped);
         phy->recordScalar("nbFramesWithoutInterferenceDropped", nbFramesWithoutInterferenceDropped);
+        phy->recordScalar("nbSenseRecomputations"             , nbSenseRecomputations);
+        phy->recordScalar("nbSenseRecomputationsAvoided"      , nbSenseRecomputationsAvoided);
     }
     Decider::finish();
 }
@@ -196,6 +196,20 @@ protected:
 	 * start-time */
 	CSRInfo currentChannelSenseRequest;
 
+	/** @name Channel state the answer time of the current ChannelSenseRequest
+	 * was calculated for.*/
+	/*@{*/
+	bool      senseEdgeProcessing;
+	simtime_t senseEdgeBusyEnd;
+	/*@}*/
+
+	/** @name Number of channel state changes during a ChannelSenseRequest
+	 * which needed, or did not need, a new answer time.*/
+	/*@{*/
+	unsigned long nbSenseRecomputations;
+	unsigned long nbSenseRecomputationsAvoided;
+	/*@}*/
+
 	/** @brief index for this Decider-instance given by Phy-Layer (mostly
 	 * Host-index) */
 	int myIndex;
@@ -224,6 +238,10 @@ public:
 		, sensitivity(sensitivity)
 		, currentSignal(NULL, NEW)
 		, currentChannelSenseRequest()
+		, senseEdgeProcessing(false)
+		, senseEdgeBusyEnd()
+		, nbSenseRecomputations(0)
+		, nbSenseRecomputationsAvoided(0)
 		, myIndex(myIndex)
 		, debug(debug)
 	{
@@ -400,6 +418,29 @@ protected:
 	 */
 	virtual simtime_t canAnswerCSR(const CSRInfo& requestInfo) const;
 
+	/**
+	 * @brief Returns true if the channel state "canAnswerCSR" depends on
+	 * has changed since the answer time of the current ChannelSenseRequest
+	 * was calculated.
+	 *
+	 * The default implementation of "canAnswerCSR" only depends on whether a
+	 * signal is received and on the end of the last signal on the channel
+	 * (the busy/idle edge), so most signal events do not change the answer
+	 * time and need no recalculation.
+	 * Deciders whose "canAnswerCSR" depends on more (e.g. the RSSI course)
+	 * have to override this method to return true.
+	 */
+	virtual bool senseEdgeChanged() const {
+		return senseEdgeProcessing != currentSignal.isProcessing()
+		    || senseEdgeBusyEnd    != currentSignal.getBusyEndTime();
+	}
+
+	/** @brief Remembers the channel state an answer time was calculated for.*/
+	void storeSenseEdge() {
+		senseEdgeProcessing = currentSignal.isProcessing();
+		senseEdgeBusyEnd    = currentSignal.getBusyEndTime();
+	}
+
 	/** @brief Return type of BaseDecider::calcChannelSenseRSSI function.
 	 *
 	 *  The pair consists in first part the RSSI value and in second part
@@ -16,6 +16,8 @@ Define_Module(BasePhyLayer);
 
 short BasePhyLayer::airFramePriority = 10;
 
+BasePhyLayer::XMLParameterCache BasePhyLayer::xmlParameterCache;
+
 Coord NoMobiltyPos = Coord::ZERO;
 
 template<typename _Tp>
@@ -165,27 +167,19 @@ MiximRadio* BasePhyLayer::initializeRadio() const {
 }
 
 void BasePhyLayer::getParametersFromXML(cXMLElement* xmlData, ParameterMap& outputMap) const {
-	cXMLElementList parameters = xmlData->getElementsByTagName("Parameter");
+	const XMLParameterList& parameters = getCachedXMLParameters(xmlData);
 
-	for(cXMLElementList::const_iterator it = parameters.begin();
+	for(XMLParameterList::const_iterator it = parameters.begin();
 		it != parameters.end(); it++) {
 
-		const char* name = (*it)->getAttribute("name");
-		const char* type = (*it)->getAttribute("type");
-		const char* value = (*it)->getAttribute("value");
-		if(name == 0 || type == 0 || value == 0) {
-			ev << "Invalid parameter, could not find name, type or value." << endl;
-			continue;
-		}
+		const std::string& sType  = it->type;
+		const char*        value  = it->value.c_str();
 
-		std::string sType = type; 	//needed for easier comparision
-		std::string sValue = value;	//needed for easier comparision
-
-		cMsgPar param(name);
+		cMsgPar param(it->name.c_str());
 
 		//parse type of parameter and set value
 		if (sType == "bool") {
-			param.setBoolValue(sValue == "true" || sValue == "1");
+			param.setBoolValue(it->value == "true" || it->value == "1");
 
 		} else if (sType == "double") {
 			param.setDoubleValue(strtod(value, 0));
@@ -202,13 +196,58 @@ void BasePhyLayer::getParametersFromXML(cXMLElement* xmlData, ParameterMap& outp
 		}
 
 		//add parameter to output map
-		outputMap[name] = param;
+		outputMap[it->name] = param;
 	}
 }
 
+void BasePhyLayer::clearXMLParameterCache() {
+	xmlParameterCache.clear();
+}
+
+const BasePhyLayer::XMLParameterList& BasePhyLayer::getCachedXMLParameters(cXMLElement* xmlData) const {
+	const char *const           location = xmlData->getSourceLocation();
+	XMLParameterCache::iterator it       = xmlParameterCache.find(xmlData);
+
+	// the element pointer could be reused by a newly loaded document, so the
+	// source location has to match as well
+	if(it != xmlParameterCache.end() && it->second.sourceLocation == (location ? location : "")) {
+		coreEV << "Reusing parsed parameters of " << xmlData->getTagName() << " from " << it->second.sourceLocation << "." << endl;
+		return it->second.params;
+	}
+
+	XMLParameterEntry& entry = xmlParameterCache[xmlData];
+	entry.sourceLocation = location ? location : "";
+	entry.params.clear();
+
+	cXMLElementList parameters = xmlData->getElementsByTagName("Parameter");
+
+	for(cXMLElementList::const_iterator itP = parameters.begin();
+		itP != parameters.end(); itP++) {
+
+		const char* name = (*itP)->getAttribute("name");
+		const char* type = (*itP)->getAttribute("type");
+		const char* value = (*itP)->getAttribute("value");
+		if(name == 0 || type == 0 || value == 0) {
+			ev << "Invalid parameter, could not find name, type or value." << endl;
+			continue;
+		}
+
+		XMLParameter parameter;
+		parameter.name  = name;
+		parameter.type  = type;
+		parameter.value = value;
+		entry.params.push_back(parameter);
+	}
+
+	return entry.params;
+}
+
 void BasePhyLayer::finish(){
 	// give decider the chance to do something
 	decider->finish();
+	for(AnalogueModelList::const_iterator it = analogueModels.begin(); it != analogueModels.end(); ++it) {
+		(*it)->finish();
+	}
 }
 
 //-----Decider initialization----------------------
@@ -399,13 +438,11 @@ void BasePhyLayer::handleAirFrame(airframe_ptr_t frame) {
 void BasePhyLayer::handleAirFrameStartReceive(airframe_ptr_t frame) {
 	coreEV << "Received new AirFrame " << frame << " from channel " << frame->getChannel() << "." << endl;
 
-	if(channelInfo.isChannelEmpty()) {
-		radio->setTrackingModeTo(true);
-	}
-
-	channelInfo.addAirFrame(frame, simTime());
-	assert(!channelInfo.isChannelEmpty());
+	prepareAirFrameReception(frame);
+	commitAirFrameReception(frame);
+}
 
+void BasePhyLayer::prepareAirFrameReception(airframe_ptr_t frame) {
 	if(usePropagationDelay) {
 		Signal&   s     = frame->getSignal();
 		simtime_t delay = simTime() - s.getSendingStart();
@@ -415,6 +452,15 @@ void BasePhyLayer::handleAirFrameStartReceive(airframe_ptr_t frame) {
 
 	frame->getSignal().setReceptionSenderInfo(frame);
 	filterSignal(frame);
+}
+
+void BasePhyLayer::commitAirFrameReception(airframe_ptr_t frame) {
+	if(channelInfo.isChannelEmpty()) {
+		radio->setTrackingModeTo(true);
+	}
+
+	channelInfo.addAirFrame(frame, simTime());
+	assert(!channelInfo.isChannelEmpty());
 
 	if(decider && isKnownProtocolId(frame->getProtocolId())) {
 		frame->setState(RECEIVING);
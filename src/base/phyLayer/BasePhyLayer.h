@@ -163,6 +163,42 @@ private:
 	 */
 	void getParametersFromXML(cXMLElement* xmlData, ParameterMap& outputMap) const;
 
+	/** @brief One parameter element of the XML configuration, as plain strings. */
+	struct XMLParameter {
+		std::string name;
+		std::string type;
+		std::string value;
+	};
+	/** @brief Type for the parameter elements of one XML element.*/
+	typedef std::vector<XMLParameter> XMLParameterList;
+
+	/** @brief Parameters read from one XML element of the configuration. */
+	struct XMLParameterEntry {
+		/** @brief Source location of the element, used to detect stale entries.*/
+		std::string      sourceLocation;
+		/** @brief The parameter elements.*/
+		XMLParameterList params;
+	};
+	/** @brief Type for the read XML parameters keyed by their XML element.*/
+	typedef std::map<const cXMLElement*, XMLParameterEntry> XMLParameterCache;
+
+	/**
+	 * @brief Parameters of the analogue model and decider configurations
+	 * shared between all phy layers of the simulation.
+	 *
+	 * Every node of a network normally uses the same config.xml, so the
+	 * parameter elements of each XML element are searched only once. The
+	 * cache holds plain strings: the cMsgPar objects of the ParameterMap are
+	 * owned by the module which creates them, so they are built per module.
+	 */
+	static XMLParameterCache xmlParameterCache;
+
+	/**
+	 * @brief Utility function. Returns the parameter elements of the passed
+	 * XML element, reading them only if they are not already cached.
+	 */
+	const XMLParameterList& getCachedXMLParameters(cXMLElement* xmlData) const;
+
 	/**
 	 * @brief Initializes the AnalogueModels with the data from the
 	 * passed XML-config data.
@@ -333,9 +369,29 @@ protected:
 
 	/**
 	 * @brief Handles incoming AirFrames with the state START_RECEIVE.
+	 *
+	 * The reception is split into the receiver local preparation of the
+	 * frame (see prepareAirFrameReception()) and the update of the channel
+	 * and decider state (see commitAirFrameReception()).
 	 */
 	virtual void handleAirFrameStartReceive(airframe_ptr_t msg);
 
+	/**
+	 * @brief Prepares the Signal of an AirFrame at the start of its reception.
+	 *
+	 * Sets the propagation delay and the sender information of the Signal and
+	 * filters it by the AnalogueModels. Only the passed AirFrame is changed,
+	 * neither the ChannelInfo, the radio nor the Decider are touched.
+	 */
+	virtual void prepareAirFrameReception(airframe_ptr_t frame);
+
+	/**
+	 * @brief Adds a prepared AirFrame to the channel and hands it the first
+	 * time to the Decider (or schedules it directly to its end if there is
+	 * no Decider for it).
+	 */
+	virtual void commitAirFrameReception(airframe_ptr_t frame);
+
 	/**
 	 * @brief Handles incoming AirFrames with the state RECEIVING.
 	 */
@@ -441,6 +497,14 @@ public:
 	/** @brief Only calls the deciders finish method.*/
 	virtual void finish();
 
+	/**
+	 * @brief Drops the cached XML parameters of all phy layers.
+	 *
+	 * Called by the BaseWorldUtility when the network is deleted, so a
+	 * following run in the same process reads its configuration again.
+	 */
+	static void clearXMLParameterCache();
+
 	//---------MacToPhyInterface implementation-----------
 	/**
 	 * @name MacToPhyInterface implementation
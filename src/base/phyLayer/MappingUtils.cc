@@ -236,6 +236,10 @@ Mapping::argument_value_t MappingUtils::findMax(const ConstMapping& m, const Arg
 	assert(pRangeFrom.getDimensions().isSubSet(rDimSet));
 	assert(pRangeTo.getDimensions().isSubSet(rDimSet));
 
+	const TimeFreqGridMapping *const grid = dynamic_cast<const TimeFreqGridMapping*>(&m);
+	if(grid)
+		return grid->findExtremum(pRangeFrom, pRangeTo, true, cRetNotFound);
+
 	ConstMappingIterator*     it       = m.createConstIterator(pRangeFrom);
 	bool                      bIsFirst = true;
 	Mapping::argument_value_t res;
@@ -319,6 +323,10 @@ Mapping::argument_value_t MappingUtils::findMin(const ConstMapping& m, const Arg
 	assert(pRangeFrom.getDimensions().isSubSet(rDimSet));
 	assert(pRangeTo.getDimensions().isSubSet(rDimSet));
 
+	const TimeFreqGridMapping *const grid = dynamic_cast<const TimeFreqGridMapping*>(&m);
+	if(grid)
+		return grid->findExtremum(pRangeFrom, pRangeTo, false, cRetNotFound);
+
 	Mapping::argument_value_t res;
 	bool                      bIsFirst = true;
 	ConstMappingIterator*     it       = m.createConstIterator(pRangeFrom);
@@ -418,6 +426,286 @@ simtime_t MappingUtils::incNextPosition(simtime_t_cref t)
 	return post(t);
 }
 
+TimeFreqGridMappingIterator::TimeFreqGridMappingIterator(TimeFreqGridMapping& mapping):
+	MappingIterator(), mapping(mapping),
+	position(DimensionSet::timeFreqDomain), nextPosition(DimensionSet::timeFreqDomain)
+{
+	jumpToBegin();
+}
+
+TimeFreqGridMappingIterator::TimeFreqGridMappingIterator(TimeFreqGridMapping& mapping, const Argument& pos):
+	MappingIterator(), mapping(mapping),
+	position(DimensionSet::timeFreqDomain), nextPosition(DimensionSet::timeFreqDomain)
+{
+	jumpTo(pos);
+}
+
+void TimeFreqGridMappingIterator::updateNextPosition()
+{
+	const TimeFreqGridMapping::FreqAxis& freqs = mapping.freqs;
+	const TimeFreqGridMapping::TimeAxis& times = mapping.times;
+
+	nextPosition = position;
+	if(times.empty())
+		return;
+
+	const Argument::mapped_type f = position.getArgValue(Dimension::frequency);
+	TimeFreqGridMapping::FreqAxis::const_iterator fIt = std::lower_bound(freqs.begin(), freqs.end(), f);
+
+	if(fIt != freqs.end() && *fIt == f) {
+		// on a frequency key: next time key of the same column
+		TimeFreqGridMapping::TimeAxis::const_iterator tIt = std::upper_bound(times.begin(), times.end(), position.getTime());
+		if(tIt != times.end()) {
+			nextPosition.setTime(*tIt);
+			return;
+		}
+		++fIt;
+	}
+	if(fIt != freqs.end()) {
+		nextPosition.setTime(times.front());
+		nextPosition.setArgValue(Dimension::frequency, *fIt);
+	}
+}
+
+void TimeFreqGridMappingIterator::jumpTo(const Argument& pos)
+{
+	position.setArgValues(pos, true);
+	updateNextPosition();
+}
+
+void TimeFreqGridMappingIterator::jumpToBegin()
+{
+	if(!mapping.times.empty() && !mapping.freqs.empty()) {
+		position.setTime(mapping.times.front());
+		position.setArgValue(Dimension::frequency, mapping.freqs.front());
+	}
+	updateNextPosition();
+}
+
+void TimeFreqGridMappingIterator::next()
+{
+	position = nextPosition;
+	updateNextPosition();
+}
+
+bool TimeFreqGridMappingIterator::inRange() const
+{
+	const TimeFreqGridMapping::FreqAxis& freqs = mapping.freqs;
+	const TimeFreqGridMapping::TimeAxis& times = mapping.times;
+
+	if(times.empty() || freqs.empty())
+		return false;
+
+	const Argument::mapped_type f = position.getArgValue(Dimension::frequency);
+	return    !(f < freqs.front()) && !(freqs.back() < f)
+	       && !(position.getTime() < times.front()) && !(times.back() < position.getTime());
+}
+
+bool TimeFreqGridMappingIterator::hasNext() const
+{
+	return !(nextPosition == position);
+}
+
+Mapping::argument_value_t TimeFreqGridMappingIterator::getValue() const
+{
+	return mapping.getValue(position);
+}
+
+void TimeFreqGridMappingIterator::setValue(argument_value_cref_t value)
+{
+	mapping.setValue(position, value);
+	updateNextPosition();
+}
+
+TimeFreqGridMapping::TimeFreqGridMapping(const FreqAxis& freqKeys):
+	Mapping(DimensionSet::timeFreqDomain),
+	freqs(freqKeys), times(), values(),
+	outOfRangeVal(Argument::MappedZero), continueOutOfRange(true)
+{
+	std::sort(freqs.begin(), freqs.end());
+	freqs.erase(std::unique(freqs.begin(), freqs.end()), freqs.end());
+}
+
+TimeFreqGridMapping::TimeFreqGridMapping(const FreqAxis& freqKeys, argument_value_cref_t oorv):
+	Mapping(DimensionSet::timeFreqDomain),
+	freqs(freqKeys), times(), values(),
+	outOfRangeVal(oorv), continueOutOfRange(false)
+{
+	std::sort(freqs.begin(), freqs.end());
+	freqs.erase(std::unique(freqs.begin(), freqs.end()), freqs.end());
+}
+
+Mapping::argument_value_t TimeFreqGridMapping::getColumnValue(size_t freqIdx, simtime_t_cref t) const
+{
+	const size_t nFreqs = freqs.size();
+
+	TimeAxis::const_iterator right = std::upper_bound(times.begin(), times.end(), t);
+	if(right == times.begin())
+		return continueOutOfRange ? values[freqIdx] : outOfRangeVal;
+
+	const size_t leftIdx = (right - times.begin()) - 1;
+	const argument_value_t vLeft = values[leftIdx * nFreqs + freqIdx];
+	if(times[leftIdx] == t)
+		return vLeft;
+	if(right == times.end())
+		return continueOutOfRange ? vLeft : outOfRangeVal;
+
+	const argument_value_t vRight = values[(leftIdx + 1) * nFreqs + freqIdx];
+	const argument_value_t factor = SIMTIME_DBL(t - times[leftIdx]) / SIMTIME_DBL(*right - times[leftIdx]);
+	return vLeft + (vRight - vLeft) * factor;
+}
+
+void TimeFreqGridMapping::getRow(simtime_t_cref t, argument_value_t* row) const
+{
+	const size_t nFreqs = freqs.size();
+
+	TimeAxis::const_iterator right = std::upper_bound(times.begin(), times.end(), t);
+	if(right == times.begin() || (right == times.end() && times.back() != t)) {
+		if(continueOutOfRange && !times.empty()) {
+			const argument_value_t* border = &values[(right == times.begin()) ? 0 : (times.size() - 1) * nFreqs];
+			std::copy(border, border + nFreqs, row);
+		} else {
+			std::fill(row, row + nFreqs, outOfRangeVal);
+		}
+		return;
+	}
+
+	const size_t            leftIdx = (right - times.begin()) - 1;
+	const argument_value_t* vLeft   = &values[leftIdx * nFreqs];
+	if(times[leftIdx] == t) {
+		std::copy(vLeft, vLeft + nFreqs, row);
+		return;
+	}
+
+	const argument_value_t* vRight = vLeft + nFreqs;
+	const argument_value_t  factor = SIMTIME_DBL(t - times[leftIdx]) / SIMTIME_DBL(*right - times[leftIdx]);
+	for(size_t fi = 0; fi < nFreqs; ++fi)
+		row[fi] = vLeft[fi] + (vRight[fi] - vLeft[fi]) * factor;
+}
+
+Mapping::argument_value_t TimeFreqGridMapping::getValue(const Argument& pos) const
+{
+	if(times.empty() || freqs.empty())
+		return continueOutOfRange ? Argument::MappedZero : outOfRangeVal;
+
+	const argument_value_t   f     = pos.getArgValue(Dimension::frequency);
+	FreqAxis::const_iterator right = std::upper_bound(freqs.begin(), freqs.end(), f);
+
+	if(right == freqs.begin())
+		return continueOutOfRange ? getColumnValue(0, pos.getTime()) : outOfRangeVal;
+
+	const size_t leftIdx = (right - freqs.begin()) - 1;
+	if(freqs[leftIdx] == f)
+		return getColumnValue(leftIdx, pos.getTime());
+	if(right == freqs.end())
+		return continueOutOfRange ? getColumnValue(leftIdx, pos.getTime()) : outOfRangeVal;
+
+	const argument_value_t vLeft  = getColumnValue(leftIdx,     pos.getTime());
+	const argument_value_t vRight = getColumnValue(leftIdx + 1, pos.getTime());
+	const argument_value_t factor = (f - freqs[leftIdx]) / (*right - freqs[leftIdx]);
+	return vLeft + (vRight - vLeft) * factor;
+}
+
+size_t TimeFreqGridMapping::insertTime(simtime_t_cref t)
+{
+	TimeAxis::iterator it  = std::lower_bound(times.begin(), times.end(), t);
+	const size_t       idx = it - times.begin();
+
+	if(it != times.end() && *it == t)
+		return idx;
+
+	const size_t nFreqs = freqs.size();
+	ValueGrid    row(nFreqs);
+	if(nFreqs > 0)
+		getRow(t, &row[0]);
+
+	times.insert(it, t);
+	values.insert(values.begin() + idx * nFreqs, row.begin(), row.end());
+	return idx;
+}
+
+size_t TimeFreqGridMapping::insertFreq(argument_value_cref_t f)
+{
+	FreqAxis::iterator it  = std::lower_bound(freqs.begin(), freqs.end(), f);
+	const size_t       idx = it - freqs.begin();
+
+	if(it != freqs.end() && *it == f)
+		return idx;
+
+	// the column layout changes, so the grid has to be rebuild
+	const size_t nOldFreqs = freqs.size();
+	const size_t nTimes    = times.size();
+	Argument     pos(DimensionSet::timeFreqDomain);
+	ValueGrid    newValues;
+
+	pos.setArgValue(Dimension::frequency, f);
+	newValues.reserve(nTimes * (nOldFreqs + 1));
+	for(size_t ti = 0; ti < nTimes; ++ti) {
+		const ValueGrid::const_iterator oldRow = values.begin() + ti * nOldFreqs;
+
+		pos.setTime(times[ti]);
+		newValues.insert(newValues.end(), oldRow, oldRow + idx);
+		newValues.push_back(nOldFreqs > 0 ? getValue(pos) : outOfRangeVal);
+		newValues.insert(newValues.end(), oldRow + idx, oldRow + nOldFreqs);
+	}
+
+	freqs.insert(it, f);
+	values.swap(newValues);
+	return idx;
+}
+
+void TimeFreqGridMapping::setValue(const Argument& pos, argument_value_cref_t value)
+{
+	const size_t freqIdx = insertFreq(pos.getArgValue(Dimension::frequency));
+	const size_t timeIdx = insertTime(pos.getTime());
+
+	values[timeIdx * freqs.size() + freqIdx] = value;
+}
+
+Mapping::argument_value_t TimeFreqGridMapping::findExtremum(const Argument& from, const Argument& to,
+                                                            bool findMaximum, argument_value_cref_t cRetNotFound) const
+{
+	argument_value_t res      = cRetNotFound;
+	bool             bIsFirst = true;
+
+	// the values at the borders of the range count if they are inside the grid
+	const Argument* borders[] = { &from, &to };
+	for(size_t i = 0; i < 2; ++i) {
+		Argument pos(DimensionSet::timeFreqDomain);
+		pos.setArgValues(*borders[i], true);
+
+		const argument_value_t f = pos.getArgValue(Dimension::frequency);
+		if(   times.empty() || freqs.empty()
+		   || f < freqs.front() || freqs.back() < f
+		   || pos.getTime() < times.front() || times.back() < pos.getTime())
+			continue;
+
+		const argument_value_t val = getValue(pos);
+		if(bIsFirst || (findMaximum ? val > res : val < res)) {
+			res      = val;
+			bIsFirst = false;
+		}
+	}
+
+	// and every grid point inside of the range
+	const size_t nFreqs = freqs.size();
+	const size_t fBegin = std::lower_bound(freqs.begin(), freqs.end(), from.getArgValue(Dimension::frequency)) - freqs.begin();
+	const size_t fEnd   = std::upper_bound(freqs.begin(), freqs.end(), to.getArgValue(Dimension::frequency))   - freqs.begin();
+	const size_t tBegin = std::lower_bound(times.begin(), times.end(), from.getTime()) - times.begin();
+	const size_t tEnd   = std::upper_bound(times.begin(), times.end(), to.getTime())   - times.begin();
+
+	for(size_t ti = tBegin; ti < tEnd; ++ti) {
+		const argument_value_t* row = &values[ti * nFreqs];
+		for(size_t fi = fBegin; fi < fEnd; ++fi) {
+			if(bIsFirst || (findMaximum ? row[fi] > res : row[fi] < res)) {
+				res      = row[fi];
+				bIsFirst = false;
+			}
+		}
+	}
+	return res;
+}
+
 
 /*
 Mapping* Mapping::multiply(ConstMapping &f1, ConstMapping &f2, const Argument& from, const Argument& to)
@@ -8,6 +8,9 @@
 #ifndef SIGNALINTERFACES_H_
 #define SIGNALINTERFACES_H_
 
+#include <vector>
+#include <algorithm>
+
 #include "MiXiMDefs.h"
 #include "MappingBase.h"
 
@@ -1788,6 +1791,280 @@ public:
 	}
 };
 
+class TimeFreqGridMapping;
+
+/**
+ * @brief Calls the wrapped binary operator with swapped operands.
+ *
+ * Used to combine a grid which is the second operand row by row.
+ *
+ * @ingroup mappingDetails
+ */
+template<class Operator>
+class SwappedOperands {
+protected:
+	Operator op;
+public:
+	SwappedOperands(Operator op): op(op) {}
+
+	Argument::mapped_type operator()(Argument::mapped_type_cref a, Argument::mapped_type_cref b) {
+		return op(b, a);
+	}
+};
+
+/**
+ * @brief MappingIterator implementation for TimeFreqGridMapping.
+ *
+ * Iterates over the grid points in the same order as a MultiDimMapping
+ * over time and frequency would do, which means frequency is the major
+ * and time the minor order.
+ *
+ * @ingroup mappingDetails
+ */
+class MIXIM_API TimeFreqGridMappingIterator : public MappingIterator {
+protected:
+	/** @brief The grid this iterator iterates over.*/
+	TimeFreqGridMapping& mapping;
+
+	/** @brief The current position of the iterator.*/
+	Argument position;
+
+	/** @brief The position of the next grid point after the current position.*/
+	Argument nextPosition;
+
+protected:
+	/** @brief Updates the next position from the current one.*/
+	void updateNextPosition();
+
+private:
+	/** @brief Assignment operator is not allowed.
+	 */
+	TimeFreqGridMappingIterator& operator=(const TimeFreqGridMappingIterator&);
+
+public:
+	/** @brief Initializes the iterator to the first grid point of the mapping.*/
+	TimeFreqGridMappingIterator(TimeFreqGridMapping& mapping);
+
+	/** @brief Initializes the iterator to the passed position.*/
+	TimeFreqGridMappingIterator(TimeFreqGridMapping& mapping, const Argument& pos);
+
+	virtual ~TimeFreqGridMappingIterator() {}
+
+	virtual const Argument& getNextPosition() const { return nextPosition; }
+
+	virtual void jumpTo(const Argument& pos);
+
+	virtual void jumpToBegin();
+
+	/**
+	 * @brief The grid axes are random access, so this is the same as
+	 * "jumpTo()".
+	 */
+	virtual void iterateTo(const Argument& pos) { jumpTo(pos); }
+
+	virtual void next();
+
+	virtual bool inRange() const;
+
+	virtual bool hasNext() const;
+
+	virtual const Argument& getPosition() const { return position; }
+
+	virtual argument_value_t getValue() const;
+
+	virtual void setValue(argument_value_cref_t value);
+};
+
+/**
+ * @brief Dense linear interpolated mapping over time and frequency.
+ *
+ * The values are stored in one contiguous array with one row per time key
+ * and one column per frequency key. Signals which span several frequency
+ * bands (like the multi-channel 802.11 signals) are much cheaper to combine
+ * this way than with a MultiDimMapping, which stores one std::map based
+ * sub-mapping per frequency.
+ *
+ * Unlike MultiDimMapping the grid is dense: setting a value at a new time
+ * (or frequency) adds a whole row (or column) which is filled with the values
+ * the mapping had there before. Between the keys the values are interpolated
+ * linear in both dimensions.
+ *
+ * "MappingUtils::applyElementWiseOperator()" works directly on the rows of
+ * the grid if one operand is a TimeFreqGridMapping and the other one is
+ * either a grid with the same frequency keys or a mapping over time only.
+ * The ranged "MappingUtils::findMin()"/"findMax()" scan the grid directly.
+ *
+ * @ingroup mapping
+ */
+class MIXIM_API TimeFreqGridMapping : public Mapping {
+public:
+	/** @brief Sorted time keys of the grid.*/
+	typedef std::vector<simtime_t>        TimeAxis;
+	/** @brief Sorted frequency keys of the grid.*/
+	typedef std::vector<argument_value_t> FreqAxis;
+	/** @brief Values of the grid, stored row by row (one row per time key).*/
+	typedef std::vector<argument_value_t> ValueGrid;
+
+protected:
+	/** @brief The frequency keys.*/
+	FreqAxis         freqs;
+	/** @brief The time keys.*/
+	TimeAxis         times;
+	/** @brief The values, index is "timeIndex * freqs.size() + freqIndex".*/
+	ValueGrid        values;
+
+	/** @brief The value outside the grid if "continueOutOfRange" is false.*/
+	argument_value_t outOfRangeVal;
+	/** @brief If true the border values of the grid are continued outside of it.*/
+	bool             continueOutOfRange;
+
+	friend class TimeFreqGridMappingIterator;
+
+protected:
+	/**
+	 * @brief Returns the value of the passed frequency column at the passed
+	 * time.
+	 */
+	argument_value_t getColumnValue(size_t freqIdx, simtime_t_cref t) const;
+
+	/**
+	 * @brief Returns the index of the passed time key, inserts a new
+	 * (interpolated) row for it if the grid does not contain it yet.
+	 */
+	size_t insertTime(simtime_t_cref t);
+
+	/**
+	 * @brief Returns the index of the passed frequency key, inserts a new
+	 * (interpolated) column for it if the grid does not contain it yet.
+	 */
+	size_t insertFreq(argument_value_cref_t f);
+
+public:
+	/**
+	 * @brief Initializes an empty grid with the passed frequency keys which
+	 * continues its border values outside of its range.
+	 */
+	TimeFreqGridMapping(const FreqAxis& freqKeys = FreqAxis());
+
+	/**
+	 * @brief Initializes an empty grid with the passed frequency keys which
+	 * returns the passed value outside of its range.
+	 */
+	TimeFreqGridMapping(const FreqAxis& freqKeys, argument_value_cref_t oorv);
+
+	virtual ~TimeFreqGridMapping() {}
+
+	virtual argument_value_t getValue(const Argument& pos) const;
+
+	virtual void setValue(const Argument& pos, argument_value_cref_t value);
+
+	virtual MappingIterator* createIterator() {
+		return new TimeFreqGridMappingIterator(*this);
+	}
+
+	virtual MappingIterator* createIterator(const Argument& pos) {
+		return new TimeFreqGridMappingIterator(*this, pos);
+	}
+
+	virtual Mapping* clone() const { return new TimeFreqGridMapping(*this); }
+
+	/** @brief Returns the frequency keys of the grid.*/
+	const FreqAxis& getFreqs() const { return freqs; }
+
+	/** @brief Returns the time keys of the grid.*/
+	const TimeAxis& getTimes() const { return times; }
+
+	/**
+	 * @brief Writes the value of every frequency column at the passed time
+	 * to the passed array which has to be able to hold "getFreqs().size()"
+	 * values.
+	 */
+	void getRow(simtime_t_cref t, argument_value_t* row) const;
+
+	/**
+	 * @brief Returns the minimum (or maximum if "findMaximum" is true) value of
+	 * the grid in the box defined by the passed positions.
+	 *
+	 * Has the same semantics as the ranged "MappingUtils::findMin()" and
+	 * "MappingUtils::findMax()" but works directly on the grid rows.
+	 */
+	argument_value_t findExtremum(const Argument& from, const Argument& to,
+	                              bool findMaximum, argument_value_cref_t cRetNotFound) const;
+
+	/**
+	 * @brief Applies the passed operator element wise on the passed grid and the
+	 * passed mapping and returns the result as new grid.
+	 *
+	 * Returns NULL if "f2" is neither a grid with the same frequency keys as
+	 * "f1" nor a mapping over time only. See
+	 * "MappingUtils::applyElementWiseOperator()" for the meaning of the
+	 * other parameters.
+	 */
+	template<class Operator>
+	static Mapping* applyElementWiseOperator(const TimeFreqGridMapping& f1, const ConstMapping& f2, Operator op,
+	                                         argument_value_cref_t outOfRangeVal, bool contOutOfRange) {
+		const TimeFreqGridMapping *const g2 = dynamic_cast<const TimeFreqGridMapping*>(&f2);
+
+		if(g2 ? (g2->freqs != f1.freqs) : !(f2.getDimensionSet() == DimensionSet::timeDomain))
+			return 0;
+
+		TimeFreqGridMapping *const result = contOutOfRange ? new TimeFreqGridMapping(f1.freqs)
+		                                                   : new TimeFreqGridMapping(f1.freqs, outOfRangeVal);
+
+		// the result has a row at every time key of one of the operands
+		TimeAxis& resTimes = result->times;
+		TimeAxis  f2Times;
+		if(g2) {
+			resTimes.resize(f1.times.size() + g2->times.size());
+			resTimes.erase(std::set_union(f1.times.begin(), f1.times.end(),
+			                              g2->times.begin(), g2->times.end(),
+			                              resTimes.begin()),
+			               resTimes.end());
+		} else {
+			ConstMappingIterator* it = f2.createConstIterator();
+			while(it->inRange()) {
+				f2Times.push_back(it->getPosition().getTime());
+				if(!it->hasNext())
+					break;
+				it->next();
+			}
+			delete it;
+
+			resTimes.resize(f1.times.size() + f2Times.size());
+			resTimes.erase(std::set_union(f1.times.begin(), f1.times.end(),
+			                              f2Times.begin(), f2Times.end(),
+			                              resTimes.begin()),
+			               resTimes.end());
+		}
+
+		const size_t nFreqs = f1.freqs.size();
+		const size_t nTimes = resTimes.size();
+		result->values.resize(nTimes * nFreqs);
+
+		ValueGrid row2(g2 ? nFreqs : 0);
+		for(size_t ti = 0; ti < nTimes; ++ti) {
+			argument_value_t *const resRow = &result->values[ti * nFreqs];
+
+			f1.getRow(resTimes[ti], resRow);
+			if(g2) {
+				g2->getRow(resTimes[ti], &row2[0]);
+				for(size_t fi = 0; fi < nFreqs; ++fi)
+					resRow[fi] = op(resRow[fi], row2[fi]);
+			} else {
+				// like the generic implementation (see FilledUpMapping) the time
+				// only mapping keeps its border values out of its key range
+				simtime_t t2 = resTimes[ti];
+				if(!f2Times.empty())
+					t2 = std::min(std::max(t2, f2Times.front()), f2Times.back());
+				argument_value_cref_t v2 = f2.getValue(Argument(t2));
+				for(size_t fi = 0; fi < nFreqs; ++fi)
+					resRow[fi] = op(resRow[fi], v2);
+			}
+		}
+		return result;
+	}
+};
+
 /**
  * @brief Provides several utility methods for Mappings.
  *
@@ -1851,6 +2128,20 @@ public:
 
 		using std::operator<<;
 
+		// dense grids are combined row by row, no matter which operand is the grid
+		const TimeFreqGridMapping *const gridF1 = dynamic_cast<const TimeFreqGridMapping*>(&f1);
+		const TimeFreqGridMapping *const gridF2 = dynamic_cast<const TimeFreqGridMapping*>(&f2);
+		if(gridF1) {
+			Mapping *const gridResult = TimeFreqGridMapping::applyElementWiseOperator(*gridF1, f2, op, outOfRangeVal, contOutOfRange);
+			if(gridResult)
+				return gridResult;
+		} else if(gridF2) {
+			Mapping *const gridResult = TimeFreqGridMapping::applyElementWiseOperator(*gridF2, f1, SwappedOperands<Operator>(op),
+			                                                                           outOfRangeVal, contOutOfRange);
+			if(gridResult)
+				return gridResult;
+		}
+
 		const ConstMapping *const f2Comp = createCompatibleMapping(f2, f1);
 		const ConstMapping *const f1Comp = createCompatibleMapping(f1, f2);
 
@@ -29,7 +29,7 @@ void RadioStateAnalogueModel::cleanUpUntil(simtime_t_cref t)
 	// ==> clear complete list except the last element, return
 	if ( t > radioStateAttenuation.back().getTime() )
 	{
-		radioStateAttenuation.erase(radioStateAttenuation.begin(), --radioStateAttenuation.end());
+		eraseUntil(--radioStateAttenuation.end());
 		return;
 	}
 
@@ -47,7 +47,7 @@ void RadioStateAnalogueModel::cleanUpUntil(simtime_t_cref t)
 	// CASE: list contains an element with exactly the given key
 	if ( it != radioStateAttenuation.end() && !(t < *it) )
 	{
-		radioStateAttenuation.erase(radioStateAttenuation.begin(), it);
+		eraseUntil(it);
 		return;
 	}
 
@@ -56,7 +56,7 @@ void RadioStateAnalogueModel::cleanUpUntil(simtime_t_cref t)
 	--it; // go back one element, possible since this one has not been the first one
 
 	it->setTime(t); // set this elements time to t
-	radioStateAttenuation.erase(radioStateAttenuation.begin(), it); // and erase all previous elements
+	eraseUntil(it); // and erase all previous elements
 }
 
 void RadioStateAnalogueModel::writeRecvEntry(simtime_t_cref time, Argument::mapped_type_cref value)
@@ -193,7 +193,7 @@ RSAMConstMappingIterator::RSAMConstMappingIterator( const RadioStateAnalogueMode
                                                     simtime_t_cref                 signalEnd )
 	: ConstMappingIterator()
 	, rsam(rsam)
-	, it()
+	, index(rsam->erasedEntries)
 	, position()
 	, nextPosition()
 	, signalStart(signalStart)
@@ -219,9 +219,8 @@ void RSAMConstMappingIterator::jumpTo(const Argument& pos)
 		return;
 
 	// this automatically goes over all zero time switches
-	it = upper_bound(rsam->radioStateAttenuation.begin(), rsam->radioStateAttenuation.end(), t);
+	index = lastIndexNotAfter(t, rsam->erasedEntries);
 
-	--it;
 	position.setTime(t);
 	setNextPosition();
 }
@@ -235,16 +234,16 @@ void RSAMConstMappingIterator::setNextPosition()
 			nextPosition.setTime(signalStart);
 		} else
 		{
-		    RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator it2 = it;
-			++it2;
+			const RadioStateAnalogueModel::ListEntry& current = entryAt(index);
+			const RadioStateAnalogueModel::ListEntry& next    = entryAt(index + 1);
 
-			assert(it->getTime() <= position.getTime() && position.getTime() < it2->getTime());
+			assert(current.getTime() <= position.getTime() && position.getTime() < next.getTime());
 
 			//point in time for the "pre step" of the next real key entry
-			simtime_t_cref preTime = MappingUtils::pre(it2->getTime());
+			simtime_t_cref preTime = MappingUtils::pre(next.getTime());
 
 			if(position.getTime() == preTime) {
-				nextPosition.setTime(it2->getTime());
+				nextPosition.setTime(next.getTime());
 			}
 			else {
 				nextPosition.setTime(preTime);
@@ -298,30 +297,41 @@ bool RSAMConstMappingIterator::hasNext() const
 {
 	assert( !(rsam->radioStateAttenuation.empty()) );
 
-	RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator it2 = it;
-	if (it2 != rsam->radioStateAttenuation.end())
+	const size_t itEnd = endIndex();
+	size_t       next  = index;
+	if (next != itEnd)
 	{
-		++it2;
+		++next;
 	}
 
 	return 	position.getTime() < signalStart
-			|| (it2 != rsam->radioStateAttenuation.end() && it2->getTime() <= signalEnd);
+			|| (next != itEnd && entryAt(next).getTime() <= signalEnd);
 }
 
 void RSAMConstMappingIterator::iterateToOverZeroSwitches(simtime_t_cref t)
 {
-    RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator itEnd = rsam->radioStateAttenuation.end();
-	if( it != itEnd && !(t < it->getTime()) )
+	if( index != endIndex() && !(t < entryAt(index).getTime()) )
 	{
-		// and go over (ignore) all zero-time-switches, to the next greater entry (time)
-		while( it != itEnd && !(t < it->getTime()) )
-			++it;
-
-		// go back one step, here the iterator 'it' is placed right
-		--it;
+		// go over (ignore) all zero-time-switches, to the last entry not after t
+		index = lastIndexNotAfter(t, index);
 	}
 }
 
+size_t RSAMConstMappingIterator::lastIndexNotAfter(simtime_t_cref t, size_t from) const
+{
+	assert(from >= rsam->erasedEntries && from < endIndex());
+
+	RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator itFrom =
+		rsam->radioStateAttenuation.begin() + (from - rsam->erasedEntries);
+	RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator it =
+		upper_bound(itFrom, rsam->radioStateAttenuation.end(), t);
+
+	// the entry at 'from' is not after t, so 'it' has a valid predecessor
+	assert(it != itFrom);
+
+	return rsam->erasedEntries + (it - rsam->radioStateAttenuation.begin()) - 1;
+}
+
 RSAMMapping::argument_value_t RSAMMapping::getValue(const Argument& pos) const
 {
 	// extract the time-component from the argument
@@ -2,7 +2,7 @@
 #define PHYUTILS_H_
 
 #include <cassert>
-#include <list>
+#include <deque>
 #include <omnetpp.h>
 
 #include "MiXiMDefs.h"
@@ -114,11 +114,33 @@ protected:
 	bool currentlyTracking;
 
 public:
-	/** @brief The type to hold the attenuation's over time. */
-	typedef std::list<ListEntry> time_attenuation_collection_type;
+	/**
+	 * @brief The type to hold the attenuation's over time.
+	 *
+	 * Entries are only appended at the back and removed from the front, so a
+	 * contiguous double ended queue gives binary search lookups and
+	 * amortised constant time clean up.
+	 */
+	typedef std::deque<ListEntry> time_attenuation_collection_type;
 	/** @brief Data structure to track the Radios attenuation over time.*/
 	time_attenuation_collection_type radioStateAttenuation;
 
+protected:
+	/**
+	 * @brief Number of entries removed from the front of radioStateAttenuation
+	 * since creation.
+	 *
+	 * Used by RSAMConstMappingIterator to address entries by a stable
+	 * absolute index, since appending to the queue invalidates its iterators.
+	 */
+	size_t erasedEntries;
+
+	/** @brief Erases all entries before the passed position.*/
+	void eraseUntil(time_attenuation_collection_type::iterator it) {
+		erasedEntries += it - radioStateAttenuation.begin();
+		radioStateAttenuation.erase(radioStateAttenuation.begin(), it);
+	}
+
 public:
 
 	/**
@@ -132,6 +154,7 @@ public:
 		: AnalogueModel()
 		, currentlyTracking(currentlyTracking)
 		, radioStateAttenuation()
+		, erasedEntries(0)
 	{
 		// put the initial time-stamp to the list
 		radioStateAttenuation.push_back(ListEntry(initTime, initValue));
@@ -442,8 +465,11 @@ protected:
 	/** @brief Pointer to the RSAM module.*/
 	const RadioStateAnalogueModel* rsam;
 
-	/** @brief List iterator pointing to the current position.*/
-	RadioStateAnalogueModel::time_attenuation_collection_type::const_iterator it;
+	/**
+	 * @brief Absolute index (see RadioStateAnalogueModel::erasedEntries) of
+	 * the entry at the current position.
+	 */
+	size_t index;
 
 	/** @brief The current position of this iterator.*/
 	Argument position;
@@ -455,6 +481,23 @@ protected:
 	/** @brief The end time of the signal this iterators mapping attenuates.*/
 	simtime_t signalEnd;
 
+	/** @brief Returns the entry with the passed absolute index.*/
+	const RadioStateAnalogueModel::ListEntry& entryAt(size_t idx) const {
+		assert(idx >= rsam->erasedEntries && idx < endIndex());
+		return rsam->radioStateAttenuation[idx - rsam->erasedEntries];
+	}
+
+	/** @brief Returns the absolute index behind the last entry of the RSAM.*/
+	size_t endIndex() const {
+		return rsam->erasedEntries + rsam->radioStateAttenuation.size();
+	}
+
+	/**
+	 * @brief Returns the absolute index of the last entry with a time-point
+	 * not after t, searching from the passed absolute index on.
+	 */
+	size_t lastIndexNotAfter(simtime_t_cref t, size_t from) const;
+
 private:
 	/** @brief Copy constructor is not allowed.
 	 */
@@ -548,7 +591,7 @@ public:
 	 * position.
 	 */
 	virtual argument_value_t getValue() const {
-		return it->getValue();
+		return entryAt(index).getValue();
 	}
 
 	/**
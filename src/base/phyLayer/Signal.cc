@@ -6,8 +6,8 @@ Signal::Signal(simtime_t_cref sendingStart, simtime_t_cref duration):
 	senderModuleID(-1), senderFromGateID(-1), receiverModuleID(-1), receiverToGateID(-1),
 	sendingStart(sendingStart), duration(duration),
 	propagationDelay(0),
-	power(NULL), bitrate(NULL),
-	txBitrate(NULL),
+	power(), bitrate(),
+	delayedPower(NULL), delayedBitrate(NULL),
 	attenuations(), rcvPower(NULL)
 {}
 
@@ -15,22 +15,10 @@ Signal::Signal(const Signal & o):
 	senderModuleID(o.senderModuleID), senderFromGateID(o.senderFromGateID), receiverModuleID(o.receiverModuleID), receiverToGateID(o.receiverToGateID),
 	sendingStart(o.sendingStart), duration(o.duration),
 	propagationDelay(o.propagationDelay),
-	power(NULL), bitrate(NULL),
-	txBitrate(NULL),
+	power(o.power), bitrate(o.bitrate),
+	delayedPower(NULL), delayedBitrate(NULL),
 	attenuations(), rcvPower(NULL)
 {
-	if (o.power) {
-		power = o.power->constClone();
-	}
-
-	if (o.bitrate) {
-		bitrate = o.bitrate->clone();
-	}
-
-	if (o.txBitrate) {
-		txBitrate = o.txBitrate->clone();
-	}
-
 	for(ConstMappingList::const_iterator it = o.attenuations.begin();
 		it != o.attenuations.end(); it++){
 		attenuations.push_back((*it)->constClone());
@@ -46,31 +34,15 @@ Signal& Signal::operator=(const Signal& o) {
 	receiverModuleID = o.receiverModuleID;
 	receiverToGateID = o.receiverToGateID;
 
-	markRcvPowerOutdated();
-
-	if(power){
-		delete power;
-		power = NULL;
-	}
-
-	if(bitrate){
-		delete bitrate;
-		bitrate = NULL;
-	}
+	markPowerOutdated();
 
-	if(txBitrate){
-		delete txBitrate;
-		txBitrate = NULL;
+	if(delayedBitrate){
+		delete delayedBitrate;
+		delayedBitrate = NULL;
 	}
 
-	if(o.power)
-		power = o.power->constClone();
-
-	if(o.bitrate)
-		bitrate = o.bitrate->clone();
-
-	if(o.txBitrate)
-		txBitrate = o.txBitrate->clone();
+	power   = o.power;
+	bitrate = o.bitrate;
 
 	for(ConstMappingList::const_iterator it = attenuations.begin();
 		it != attenuations.end(); ++it){
@@ -95,32 +67,24 @@ void Signal::swap(Signal& s) {
 	std::swap(sendingStart,     s.sendingStart);
 	std::swap(duration,         s.duration);
 	std::swap(propagationDelay, s.propagationDelay);
-	std::swap(power,            s.power);
-	std::swap(bitrate,          s.bitrate);
-	std::swap(txBitrate,        s.txBitrate);
+	power.swap(s.power);
+	bitrate.swap(s.bitrate);
+	std::swap(delayedPower,     s.delayedPower);
+	std::swap(delayedBitrate,   s.delayedBitrate);
 	std::swap(attenuations,     s.attenuations);
 	std::swap(rcvPower,         s.rcvPower);
 }
 
 Signal::~Signal()
 {
-	if(rcvPower){
-		if(propagationDelay != 0){
-			assert(rcvPower->getRefMapping() != power);
-			delete rcvPower->getRefMapping();
-		}
-
+	if(rcvPower)
 		delete rcvPower;
-	}
-
-	if(power)
-		delete power;
 
-	if(bitrate)
-		delete bitrate;
+	if(delayedPower)
+		delete delayedPower;
 
-	if(txBitrate)
-		delete txBitrate;
+	if(delayedBitrate)
+		delete delayedBitrate;
 
 	for(ConstMappingList::iterator it = attenuations.begin();
 		it != attenuations.end(); it++) {
@@ -155,36 +119,27 @@ simtime_t_cref Signal::getPropagationDelay() const {
 
 void Signal::setPropagationDelay(simtime_t_cref delay) {
 	assert(propagationDelay == 0);
-	assert(!txBitrate);
+	assert(!delayedBitrate);
 
-	markRcvPowerOutdated();
+	markPowerOutdated();
 
+	// the delay is applied when the mappings are evaluated, the (shared)
+	// power and bitrate mappings themselves stay untouched
 	propagationDelay = delay;
-
-	if(bitrate) {
-		txBitrate = bitrate;
-		bitrate = new DelayedMapping(txBitrate, propagationDelay);
-	}
 }
 
 void Signal::setTransmissionPower(ConstMapping *power)
 {
-	if(this->power){
-		markRcvPowerOutdated();
-		delete this->power;
-	}
+	markPowerOutdated();
 
-	this->power = power;
+	this->power.reset(power);
 }
 
 void Signal::setBitrate(Mapping *bitrate)
 {
-	assert(!txBitrate);
-
-	if(this->bitrate)
-		delete this->bitrate;
+	assert(!delayedBitrate);
 
-	this->bitrate = bitrate;
+	this->bitrate.reset(bitrate);
 }
 
 cGate *Signal::getSendingGate() const
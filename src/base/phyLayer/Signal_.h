@@ -42,6 +42,75 @@ public:
 	typedef std::list<ConstMapping*> ConstMappingList;
 
 protected:
+	/**
+	 * @brief Reference counted pointer to a Mapping which is shared between
+	 * all copies of a Signal.
+	 *
+	 * The transmission power and the bitrate are defined by the sender and
+	 * are not changed afterwards, so the copies of the Signal delivered to
+	 * every receiver can use the same Mapping instances instead of cloning
+	 * them.
+	 */
+	template<class T>
+	class SharedMappingPtr {
+	protected:
+		/** @brief The shared mapping.*/
+		T*        mapping;
+		/** @brief Number of SharedMappingPtr instances using the mapping.*/
+		unsigned* refCount;
+
+	public:
+		explicit SharedMappingPtr(T* m = NULL)
+			: mapping(m)
+			, refCount(m ? new unsigned(1) : NULL)
+		{}
+
+		SharedMappingPtr(const SharedMappingPtr& o)
+			: mapping(o.mapping)
+			, refCount(o.refCount)
+		{
+			if(refCount)
+				++(*refCount);
+		}
+
+		SharedMappingPtr& operator=(const SharedMappingPtr& copy) {
+			SharedMappingPtr tmp(copy);
+
+			swap(tmp);
+			return *this;
+		}
+
+		~SharedMappingPtr() {
+			if(refCount && --(*refCount) == 0) {
+				delete mapping;
+				delete refCount;
+			}
+		}
+
+		/** @brief Swaps the shared mapping with another SharedMappingPtr.*/
+		void swap(SharedMappingPtr& s) {
+			std::swap(mapping,  s.mapping);
+			std::swap(refCount, s.refCount);
+		}
+
+		/** @brief Releases the current mapping and takes ownership of the passed one.*/
+		void reset(T* m = NULL) {
+			SharedMappingPtr tmp(m);
+
+			swap(tmp);
+		}
+
+		/** @brief Returns the shared mapping.*/
+		T* get() const {
+			return mapping;
+		}
+
+		/** @brief Returns true if no other SharedMappingPtr uses the mapping.*/
+		bool unique() const {
+			return !refCount || *refCount == 1;
+		}
+	};
+
 	/** @brief Sender module id, additional definition here because BasePhyLayer will do some selfMessages with AirFrame. */
 	int senderModuleID;
 	/** @brief Sender gate id, additional definition here because BasePhyLayer will do some selfMessages with AirFrame. */
@@ -54,17 +123,33 @@ protected:
 	simtime_t sendingStart;
 	/** @brief The duration of the signal transmission.*/
 	simtime_t duration;
-	/** @brief The propagation delay of the transmission. */
+	/**
+	 * @brief The propagation delay of the transmission.
+	 *
+	 * The power and bitrate mappings are defined in sender time, the delay is
+	 * the time offset applied to them when they are evaluated at the receiver.
+	 */
 	simtime_t propagationDelay;
 
-	/** @brief Stores the function which describes the power of the signal*/
-	ConstMapping* power;
+	/** @brief Stores the function which describes the power of the signal (in sender time)*/
+	SharedMappingPtr<ConstMapping> power;
 
-	/** @brief Stores the function which describes the bitrate of the signal*/
-	Mapping* bitrate;
+	/** @brief Stores the function which describes the bitrate of the signal (in sender time)*/
+	SharedMappingPtr<Mapping> bitrate;
 
-	/** @brief If propagation delay is not zero this stores the undelayed bitrate*/
-	Mapping* txBitrate;
+	/**
+	 * @brief Power mapping moved by the propagation delay.
+	 *
+	 * Only created on access if the propagation delay is not zero.
+	 */
+	mutable ConstDelayedMapping* delayedPower;
+
+	/**
+	 * @brief Bitrate mapping moved by the propagation delay.
+	 *
+	 * Only created on access if the propagation delay is not zero.
+	 */
+	mutable ConstDelayedMapping* delayedBitrate;
 
 	/** @brief Stores the functions describing the attenuations of the signal*/
 	ConstMappingList attenuations;
@@ -81,17 +166,26 @@ protected:
 	 * out-dated.
 	 *
 	 * This happens when transmission power or propagation delay changes.
+	 * Adding an attenuation does not outdate it.
 	 */
 	void markRcvPowerOutdated() {
 		if(rcvPower){
-			if(propagationDelay != 0) {
-				assert(rcvPower->getRefMapping() != power);
-				delete rcvPower->getRefMapping();
-			}
 			delete rcvPower;
 			rcvPower = 0;
 		}
 	}
+
+	/**
+	 * @brief Deletes the delayed views of the power and rcvPower because
+	 * the transmission power mapping or the propagation delay changed.
+	 */
+	void markPowerOutdated() {
+		markRcvPowerOutdated();
+		if(delayedPower){
+			delete delayedPower;
+			delayedPower = 0;
+		}
+	}
 public:
 
 	/**
@@ -178,7 +272,8 @@ public:
 	/**
 	 * @brief Sets the function representing the bitrate of the signal.
 	 *
-	 * The ownership of the passed pointer goes to the signal.
+	 * The ownership of the passed pointer goes to the signal. It has to be
+	 * set before the propagation delay.
 	 */
 	void setBitrate(Mapping* bitrate);
 
@@ -199,13 +294,21 @@ public:
 
 	/**
 	 * @brief Returns the function representing the transmission power
-	 * of the signal.
+	 * of the signal for changing it.
 	 *
 	 * Be aware that the transmission power mapping is not yet affected
 	 * by the propagation delay!
+	 *
+	 * If the mapping is shared with copies of this signal it is cloned
+	 * first (copy on write), so changes through the returned pointer only
+	 * affect this signal. Use "getTransmissionPower()" to only read it.
 	 */
-	ConstMapping* getTransmissionPower() {
-		return power;
+	ConstMapping* getMutableTransmissionPower() {
+		if(!power.unique()) {
+			markPowerOutdated();
+			power.reset(power.get()->constClone());
+		}
+		return power.get();
 	}
 
 	/**
@@ -216,15 +319,23 @@ public:
 	 * by the propagation delay!
 	 */
 	const ConstMapping* getTransmissionPower() const {
-		return power;
+		return power.get();
 	}
 
 	/**
 	 * @brief Returns the function representing the bitrate of the
 	 * signal.
+	 *
+	 * The returned mapping already includes the propagation delay.
 	 */
-	const Mapping* getBitrate() const {
-		return bitrate;
+	const ConstMapping* getBitrate() const {
+		if(propagationDelay == 0 || !bitrate.get())
+			return bitrate.get();
+
+		if(!delayedBitrate)
+			delayedBitrate = new ConstDelayedMapping(bitrate.get(), propagationDelay);
+
+		return delayedBitrate;
 	}
 
 	/**
@@ -245,11 +356,11 @@ public:
 	const MultipliedMapping* getReceivingPower() const {
 		if(!rcvPower)
 		{
-			ConstMapping* tmp = power;
+			ConstMapping* tmp = power.get();
 			if(propagationDelay != 0) {
-				tmp = new ConstDelayedMapping(power, propagationDelay);
-				// tmp will be deleted in ~Signal(), where rcvPower->getRefMapping()
-				// will be used for accessing this pointer
+				if(!delayedPower)
+					delayedPower = new ConstDelayedMapping(power.get(), propagationDelay);
+				tmp = delayedPower;
 			}
 			rcvPower = new MultipliedMapping( tmp
 			                                , attenuations.begin()
@@ -0,0 +1,130 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        DuplicateFilter.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: hashed (source, sequence number) set for duplicate detection
+ ***************************************************************************/
+
+#ifndef DUPLICATEFILTER_H_
+#define DUPLICATEFILTER_H_
+
+#include "MiXiMDefs.h"
+#include "SimpleAddress.h"
+#include "NeighborCache.h"
+
+/**
+ * @brief Remembers already seen packets by their source address and
+ * sequence number, for duplicate suppression in flooding protocols.
+ *
+ * An entry is forgotten if it has not been seen again for "holdTime"
+ * and, if the filter holds "maxEntries" entries, the entry seen longest
+ * ago is replaced by a new one.
+ *
+ * Lookups and insertions are O(1) and outdated entries are removed in
+ * bulk in the order they time out, so every packet only pays for the
+ * entries which actually expired (see NeighborCache).
+ *
+ * @ingroup utils
+ */
+template<class Address = LAddress::L3Type>
+class DuplicateFilter
+{
+public:
+	typedef size_t size_type;
+
+	/** @brief Identifies a packet: its source address and sequence number.*/
+	struct Key {
+		Address       srcAddr;
+		unsigned long seqNum;
+
+		Key(): srcAddr(), seqNum(0) {}
+		Key(const Address& src, unsigned long seq): srcAddr(src), seqNum(seq) {}
+
+		bool operator==(const Key& other) const {
+			return seqNum == other.seqNum && srcAddr == other.srcAddr;
+		}
+	};
+
+	/** @brief Hash function for the keys.*/
+	struct KeyHash {
+		LAddressHash addrHash;
+		size_t operator()(const Key& key) const {
+			return addrHash(key.srcAddr) ^ LAddressHash::mix(key.seqNum);
+		}
+	};
+
+	/** @brief Maximum number of entries of a filter which never replaces entries.*/
+	static const size_type UNBOUNDED = NeighborCache<Key, char, KeyHash>::UNBOUNDED;
+
+protected:
+	NeighborCache<Key, char, KeyHash> entries;
+	/** @brief Time after which an entry which was not seen again is forgotten.*/
+	simtime_t                         holdTime;
+
+public:
+	explicit DuplicateFilter(size_type maxEntries = UNBOUNDED, simtime_t_cref holdTime = SIMTIME_ZERO):
+		entries(maxEntries), holdTime(holdTime)
+	{}
+
+	void setMaxEntries(size_type maxEntries) { entries.setCapacity(maxEntries); }
+	size_type getMaxEntries() const { return entries.getCapacity(); }
+
+	void setHoldTime(simtime_t_cref time) { holdTime = time; }
+	simtime_t_cref getHoldTime() const { return holdTime; }
+
+	size_type size() const { return entries.size(); }
+
+	/** @brief Removes all entries not seen again for more than holdTime.*/
+	size_type expire(simtime_t_cref now) {
+		return entries.expire(expiryLimit(now));
+	}
+
+	/** @brief Returns true if the passed packet is known and not expired.*/
+	bool contains(const Address& srcAddr, unsigned long seqNum, simtime_t_cref now) {
+		expire(now);
+		return entries.find(Key(srcAddr, seqNum)) != NULL;
+	}
+
+	/**
+	 * @brief Remembers the passed packet as seen at "now".
+	 *
+	 * Returns true if it was not known before (i.e. it is no duplicate).
+	 * Known packets are kept for another holdTime.
+	 */
+	bool insert(const Address& srcAddr, unsigned long seqNum, simtime_t_cref now) {
+		expire(now);
+		bool isNew = false;
+		entries.refresh(Key(srcAddr, seqNum), now, &isNew);
+		return isNew;
+	}
+
+	/** @brief Forgets the passed packet, returns false if it was not known.*/
+	bool erase(const Address& srcAddr, unsigned long seqNum) {
+		return entries.erase(Key(srcAddr, seqNum));
+	}
+
+	/** @brief Forgets all packets.*/
+	void clear() { entries.clear(); }
+
+protected:
+	/**
+	 * @brief Latest time an entry outdated at "now" was seen: an entry is
+	 * kept while "now" does not exceed its last sighting plus holdTime.
+	 */
+	simtime_t expiryLimit(simtime_t_cref now) const {
+		simtime_t limit = now - holdTime;
+		limit.setRaw(SIMTIME_RAW(limit) - 1);
+		return limit;
+	}
+};
+
+template<class Address>
+const typename DuplicateFilter<Address>::size_type DuplicateFilter<Address>::UNBOUNDED;
+
+#endif /* DUPLICATEFILTER_H_ */
@@ -0,0 +1,57 @@
+/***************************************************************************
+ * file:        FindModule.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************/
+#include "FindModule.h"
+
+#include <algorithm>
+
+std::vector<cModule*>& GlobalModuleRegistry::modules()
+{
+	static std::vector<cModule*> registered;
+	return registered;
+}
+
+GlobalModuleRegistry::TypeCache& GlobalModuleRegistry::cache()
+{
+	static TypeCache matches;
+	return matches;
+}
+
+GlobalModuleRegistry::Profile& GlobalModuleRegistry::profile()
+{
+	static Profile counts;
+	return counts;
+}
+
+void GlobalModuleRegistry::add(cModule* module)
+{
+	modules().push_back(module);
+	cache().clear();
+}
+
+void GlobalModuleRegistry::remove(cModule* module)
+{
+	std::vector<cModule*>& registered = modules();
+	registered.erase(std::remove(registered.begin(), registered.end(), module), registered.end());
+	cache().clear();
+	// the network is being deleted, the next run counts from zero
+	if (registered.empty())
+		profile().clear();
+}
+
+void GlobalModuleRegistry::printProfile(std::ostream& os)
+{
+	for (Profile::const_iterator it = profile().begin(); it != profile().end(); ++it) {
+		os << "FindModule::findGlobalModule<" << opp_typename(*it->first) << ">: "
+		   << it->second.lookups << " lookups, "
+		   << it->second.treeSearches << " module tree searches" << endl;
+	}
+}
@@ -1,7 +1,98 @@
 #ifndef FIND_MODULE_H
 #define FIND_MODULE_H
 
-#include <omnetpp.h>
+#include <vector>
+#include <map>
+#include <typeinfo>
+#include <ostream>
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Registry of the modules which exist once per network (world
+ * utility, connection manager, tracer...), so that
+ * FindModule::findGlobalModule() does not search the whole module tree
+ * for every node.
+ *
+ * Such modules add themselves in their constructor and remove themselves
+ * in their destructor. The result of a lookup is cached per requested
+ * type until the registry changes. If several registered modules match,
+ * the one registered first is returned.
+ *
+ * Lookups and fallback tree searches are counted per type, printProfile()
+ * shows which lookups still search the module tree. The counts are reset
+ * when the last registered module is removed, i.e. with the network of a
+ * run.
+ *
+ * @ingroup baseUtils
+ * @ingroup utils
+ */
+class MIXIM_API GlobalModuleRegistry
+{
+public:
+	/** @brief Lookup counts of one type.*/
+	struct LookupCount {
+		unsigned long lookups;
+		unsigned long treeSearches;
+
+		LookupCount(): lookups(0), treeSearches(0) {}
+	};
+
+	/** @brief Orders types by std::type_info::before().*/
+	struct TypeLess {
+		bool operator()(const std::type_info* a, const std::type_info* b) const {
+			return a->before(*b) != 0;
+		}
+	};
+
+	typedef std::map<const std::type_info*, LookupCount, TypeLess> Profile;
+
+protected:
+	typedef std::map<const std::type_info*, cModule*, TypeLess> TypeCache;
+
+	static std::vector<cModule*>& modules();
+	/** @brief Registered module for each type looked up, NULL if there is none.*/
+	static TypeCache& cache();
+	static Profile& profile();
+
+public:
+	/** @brief Registers the passed module, call it from the constructor.*/
+	static void add(cModule* module);
+
+	/**
+	 * @brief Removes the passed module, call it from the destructor. Resets
+	 * the lookup counts if no module is left.
+	 */
+	static void remove(cModule* module);
+
+	/** @brief Returns the registered module of type T or NULL.*/
+	template<typename T>
+	static T find() {
+		const std::type_info* const type = &typeid(T);
+		++profile()[type].lookups;
+
+		TypeCache::iterator it = cache().find(type);
+		if (it == cache().end()) {
+			cModule* match = NULL;
+			for (std::vector<cModule*>::const_iterator m = modules().begin(); m != modules().end() && match == NULL; ++m) {
+				if (dynamic_cast<T>(*m) != NULL)
+					match = *m;
+			}
+			it = cache().insert(std::make_pair(type, match)).first;
+		}
+		return (it->second == NULL) ? NULL : dynamic_cast<T>(it->second);
+	}
+
+	/** @brief Counts a lookup of the passed type which had to search the module tree.*/
+	static void countTreeSearch(const std::type_info& type) {
+		++profile()[&type].treeSearches;
+	}
+
+	static const Profile& getProfile() { return profile(); }
+
+	/** @brief Writes the lookup counts per type to the passed stream.*/
+	static void printProfile(std::ostream& os);
+};
 
 /**
  * @brief Provides method templates to find omnet modules.
@@ -40,11 +131,19 @@ class FindModule
          * @brief Returns a pointer to the module with the type of this
          * template.
          *
+         * Consults the GlobalModuleRegistry first and searches the whole
+         * module tree only if no registered module matches.
+         *
          * Returns NULL if no module of this type could be found.
          */
         static T findGlobalModule()
         {
-            return findSubModule(simulation.getSystemModule());
+            T found = GlobalModuleRegistry::find<T>();
+            if (found == NULL) {
+                GlobalModuleRegistry::countTreeSearch(typeid(T));
+                found = findSubModule(simulation.getSystemModule());
+            }
+            return found;
         }
 
         /**
@@ -0,0 +1,287 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        NeighborCache.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: hashed per-neighbor table with LRU eviction and age expiry
+ ***************************************************************************/
+
+#ifndef NEIGHBORCACHE_H_
+#define NEIGHBORCACHE_H_
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+#include "SimpleAddress.h"
+
+/**
+ * @brief Hash function for layer addresses (LAddress::L2Type and
+ * LAddress::L3Type).
+ *
+ * @ingroup utils
+ */
+struct LAddressHash
+{
+	size_t operator()(long address) const {
+		return mix(static_cast<unsigned long>(address));
+	}
+#ifdef MIXIM_INET
+	size_t operator()(const MACAddress& address) const {
+		return mix(static_cast<unsigned long>(address.getInt() ^ (address.getInt() >> 32)));
+	}
+#endif
+	/** @brief Spreads consecutive addresses over the buckets (Fibonacci hashing).*/
+	static size_t mix(unsigned long v) {
+		return static_cast<size_t>((v * 2654435769UL) ^ (v >> 16));
+	}
+};
+
+/**
+ * @brief Per-neighbor table which maps an address to some data.
+ *
+ * Lookups, insertions and removals are O(1): entries are stored in a hash
+ * table (chained, on a node array, so the table does not allocate once it
+ * has grown to its working size).
+ *
+ * Every entry remembers the simulation time it was last refreshed. The
+ * entries are kept in least-recently-refreshed order, which gives:
+ * - LRU eviction: if the cache holds "capacity" entries, refreshing an
+ *   unknown address replaces the entry refreshed longest ago.
+ * - Age expiry: expire() removes all entries not refreshed since a given
+ *   time, visiting only the removed entries.
+ *
+ * Pointers returned by find() and refresh() stay valid until the next call
+ * of refresh() for an unknown address, erase(), expire() or clear().
+ *
+ * @ingroup utils
+ */
+template<class Key, class Value, class Hash = LAddressHash>
+class NeighborCache
+{
+public:
+	typedef size_t size_type;
+
+	/** @brief Capacity of a cache which never evicts entries.*/
+	static const size_type UNBOUNDED = static_cast<size_type>(-1);
+
+protected:
+	enum { NONE = -1 };
+
+	/** @brief One entry, linked into its bucket chain and the LRU list.*/
+	struct Node {
+		Key       key;
+		Value     value;
+		simtime_t lastRefresh;
+		int       chain;
+		int       newer;
+		int       older;
+
+		Node(): key(), value(), lastRefresh(), chain(NONE), newer(NONE), older(NONE) {}
+	};
+
+	std::vector<Node> nodes;
+	std::vector<int>  buckets;
+	/** @brief First unused node, unused nodes are chained via "chain".*/
+	int               freeNodes;
+	/** @brief Most recently refreshed entry.*/
+	int               newest;
+	/** @brief Least recently refreshed entry.*/
+	int               oldest;
+	size_type         count;
+	size_type         capacity;
+	Hash              hash;
+
+protected:
+	size_type bucketOf(const Key& key) const {
+		return hash(key) & (buckets.size() - 1);
+	}
+
+	int findNode(const Key& key) const {
+		if (buckets.empty())
+			return NONE;
+		for (int n = buckets[bucketOf(key)]; n != NONE; n = nodes[n].chain) {
+			if (nodes[n].key == key)
+				return n;
+		}
+		return NONE;
+	}
+
+	void unlinkLru(int n) {
+		Node& node = nodes[n];
+		if (node.newer != NONE) nodes[node.newer].older = node.older; else newest = node.older;
+		if (node.older != NONE) nodes[node.older].newer = node.newer; else oldest = node.newer;
+		node.newer = node.older = NONE;
+	}
+
+	void linkNewest(int n) {
+		nodes[n].older = newest;
+		nodes[n].newer = NONE;
+		if (newest != NONE) nodes[newest].newer = n; else oldest = n;
+		newest = n;
+	}
+
+	void unlinkBucket(int n) {
+		int* link = &buckets[bucketOf(nodes[n].key)];
+		while (*link != n)
+			link = &nodes[*link].chain;
+		*link = nodes[n].chain;
+	}
+
+	void removeNode(int n) {
+		unlinkBucket(n);
+		unlinkLru(n);
+		nodes[n]       = Node();
+		nodes[n].chain = freeNodes;
+		freeNodes      = n;
+		--count;
+	}
+
+	/** @brief Doubles the number of buckets and nodes and rehashes.*/
+	void grow() {
+		const size_type newSize = nodes.empty() ? 8 : 2 * nodes.size();
+		const size_type oldSize = nodes.size();
+
+		nodes.resize(newSize);
+		for (size_type n = newSize; n > oldSize; --n) {
+			nodes[n - 1].chain = freeNodes;
+			freeNodes = static_cast<int>(n - 1);
+		}
+		buckets.assign(newSize, NONE);
+		// rehash all used entries, they are exactly the ones in the LRU list
+		for (int n = newest; n != NONE; n = nodes[n].older) {
+			const size_type b = bucketOf(nodes[n].key);
+			nodes[n].chain = buckets[b];
+			buckets[b]     = n;
+		}
+	}
+
+public:
+	explicit NeighborCache(size_type capacity = UNBOUNDED):
+		nodes(), buckets(), freeNodes(NONE), newest(NONE), oldest(NONE),
+		count(0), capacity(capacity), hash()
+	{}
+
+	size_type size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	size_type getCapacity() const { return capacity; }
+
+	/** @brief Sets the maximum number of entries, evicting the oldest ones if necessary.*/
+	void setCapacity(size_type newCapacity) {
+		capacity = newCapacity;
+		while (count > capacity)
+			removeNode(oldest);
+	}
+
+	/** @brief Returns the data for the passed address or NULL, does not refresh it.*/
+	Value* find(const Key& key) {
+		const int n = findNode(key);
+		return (n == NONE) ? NULL : &nodes[n].value;
+	}
+	const Value* find(const Key& key) const {
+		const int n = findNode(key);
+		return (n == NONE) ? NULL : &nodes[n].value;
+	}
+
+	/**
+	 * @brief Returns the data for the passed address if it has been refreshed
+	 * after "notBefore", NULL otherwise.
+	 */
+	Value* findFresh(const Key& key, simtime_t_cref notBefore) {
+		const int n = findNode(key);
+		return (n == NONE || nodes[n].lastRefresh <= notBefore) ? NULL : &nodes[n].value;
+	}
+
+	/**
+	 * @brief Returns the data for the passed address and marks it as
+	 * refreshed at "now".
+	 *
+	 * Unknown addresses get a default constructed entry, replacing the least
+	 * recently refreshed one if the cache is full. Returns NULL only for a
+	 * cache with capacity zero. If "isNew" is passed it is set to true if the
+	 * entry was created.
+	 */
+	Value* refresh(const Key& key, simtime_t_cref now, bool* isNew = NULL) {
+		int n = findNode(key);
+
+		if (isNew)
+			*isNew = (n == NONE);
+		if (n != NONE) {
+			unlinkLru(n);
+		} else {
+			if (capacity == 0)
+				return NULL;
+			if (count >= capacity)
+				removeNode(oldest);
+			if (freeNodes == NONE)
+				grow();
+
+			n              = freeNodes;
+			freeNodes      = nodes[n].chain;
+			nodes[n].key   = key;
+			nodes[n].value = Value();
+
+			const size_type b = bucketOf(key);
+			nodes[n].chain = buckets[b];
+			buckets[b]     = n;
+			++count;
+		}
+		nodes[n].lastRefresh = now;
+		linkNewest(n);
+		return &nodes[n].value;
+	}
+
+	/** @brief Removes the entry for the passed address, returns false if there is none.*/
+	bool erase(const Key& key) {
+		const int n = findNode(key);
+		if (n == NONE)
+			return false;
+		removeNode(n);
+		return true;
+	}
+
+	/**
+	 * @brief Removes all entries not refreshed after "notAfter", returns the
+	 * number of removed entries.
+	 */
+	size_type expire(simtime_t_cref notAfter) {
+		size_type removed = 0;
+		while (oldest != NONE && nodes[oldest].lastRefresh <= notAfter) {
+			removeNode(oldest);
+			++removed;
+		}
+		return removed;
+	}
+
+	/** @brief Returns the refresh time of the least recently refreshed entry.*/
+	simtime_t_cref getOldestRefresh() const {
+		assert(oldest != NONE);
+		return nodes[oldest].lastRefresh;
+	}
+
+	/** @brief Returns the address of the least recently refreshed entry.*/
+	const Key& getOldestKey() const {
+		assert(oldest != NONE);
+		return nodes[oldest].key;
+	}
+
+	/** @brief Removes all entries.*/
+	void clear() {
+		nodes.clear();
+		buckets.clear();
+		freeNodes = newest = oldest = NONE;
+		count = 0;
+	}
+};
+
+template<class Key, class Value, class Hash>
+const typename NeighborCache<Key, Value, Hash>::size_type NeighborCache<Key, Value, Hash>::UNBOUNDED;
+
+#endif /* NEIGHBORCACHE_H_ */
@@ -0,0 +1,157 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        PlainCoord.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: trivially copyable coordinate and batch distance kernels
+ ***************************************************************************/
+
+#ifndef PLAINCOORD_H_
+#define PLAINCOORD_H_
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+
+#include "MiXiMDefs.h"
+#include "Coord.h"
+
+/**
+ * @brief 3D coordinate without cObject base, for distance computations in
+ * hot paths (connection manager, analogue models).
+ *
+ * Coord derives from cObject, so each temporary of its arithmetic
+ * operators constructs a polymorphic object. PlainCoord is trivially
+ * copyable and its distance functions do not create temporaries. It
+ * converts implicitly from Coord, so Coord stays the type of all module
+ * interfaces. The distances are computed exactly like the ones of Coord.
+ *
+ * @ingroup utils
+ */
+struct PlainCoord
+{
+	double x;
+	double y;
+	double z;
+
+	PlainCoord(): x(0.0), y(0.0), z(0.0) {}
+	PlainCoord(double x, double y, double z = 0.0): x(x), y(y), z(z) {}
+	/** @brief Converts a Coord at the API boundary.*/
+	PlainCoord(const Coord& c): x(c.x), y(c.y), z(c.z) {}
+
+	/** @brief Converts back to a Coord for module interfaces.*/
+	Coord toCoord() const { return Coord(x, y, z); }
+
+	/** @brief Returns the squared distance to "a".*/
+	double sqrdist(const PlainCoord& a) const {
+		const double dx = x - a.x;
+		const double dy = y - a.y;
+		const double dz = z - a.z;
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	/** @brief Returns the distance to "a".*/
+	double distance(const PlainCoord& a) const {
+		return sqrt(sqrdist(a));
+	}
+
+	/** @brief Returns the squared distance to "b" on a torus of the passed size.*/
+	double sqrTorusDist(const PlainCoord& b, const PlainCoord& size) const {
+		const double dx = torusAxisDist(x, b.x, size.x);
+		const double dy = torusAxisDist(y, b.y, size.y);
+		const double dz = torusAxisDist(z, b.z, size.z);
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	/**
+	 * @brief Returns the distance of two values on one axis of a torus,
+	 * which is at most half of the axis size.
+	 */
+	static double torusAxisDist(double coord1, double coord2, double size) {
+		const double difference = fabs(coord1 - coord2);
+		if (difference == 0)
+			// NOTE: even if size is zero
+			return 0;
+		assert(size != 0);
+		const double dist = FWMath::modulo(difference, size);
+		return std::min(dist, size - dist);
+	}
+};
+
+/**
+ * @brief Positions stored as structure of arrays, to compute the distances
+ * of many positions to one position in a single pass.
+ *
+ * The loops of the non torus kernel have no branches and read each
+ * coordinate array sequentially, so the compiler can vectorize them.
+ *
+ * @ingroup utils
+ */
+class CoordBatch
+{
+protected:
+	std::vector<double> xs;
+	std::vector<double> ys;
+	std::vector<double> zs;
+
+public:
+	CoordBatch(): xs(), ys(), zs() {}
+
+	size_t size() const { return xs.size(); }
+	bool empty() const { return xs.empty(); }
+
+	/** @brief Removes all positions, keeps the memory.*/
+	void clear() {
+		xs.clear();
+		ys.clear();
+		zs.clear();
+	}
+
+	void reserve(size_t n) {
+		xs.reserve(n);
+		ys.reserve(n);
+		zs.reserve(n);
+	}
+
+	void push_back(const PlainCoord& c) {
+		xs.push_back(c.x);
+		ys.push_back(c.y);
+		zs.push_back(c.z);
+	}
+
+	/** @brief Writes the squared distance of position i to "p" to out[i].*/
+	void sqrDistances(const PlainCoord& p, double* out) const {
+		const size_t        n = xs.size();
+		const double* const x = n ? &xs[0] : NULL;
+		const double* const y = n ? &ys[0] : NULL;
+		const double* const z = n ? &zs[0] : NULL;
+
+		for (size_t i = 0; i < n; ++i) {
+			const double dx = p.x - x[i];
+			const double dy = p.y - y[i];
+			const double dz = p.z - z[i];
+			out[i] = dx * dx + dy * dy + dz * dz;
+		}
+	}
+
+	/** @brief Like sqrDistances() but on a torus of the passed size.*/
+	void sqrTorusDistances(const PlainCoord& p, const PlainCoord& torusSize, double* out) const {
+		const size_t n = xs.size();
+
+		for (size_t i = 0; i < n; ++i) {
+			const double dx = PlainCoord::torusAxisDist(p.x, xs[i], torusSize.x);
+			const double dy = PlainCoord::torusAxisDist(p.y, ys[i], torusSize.y);
+			const double dz = PlainCoord::torusAxisDist(p.z, zs[i], torusSize.z);
+			out[i] = dx * dx + dy * dy + dz * dz;
+		}
+	}
+};
+
+#endif /* PLAINCOORD_H_ */
@@ -0,0 +1,94 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        SequenceWindow.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: sliding window of seen sequence numbers of one origin
+ ***************************************************************************/
+
+#ifndef SEQUENCEWINDOW_H_
+#define SEQUENCEWINDOW_H_
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Remembers which sequence numbers of one origin have been seen,
+ * in constant memory.
+ *
+ * Stores the highest sequence number seen and a bit mask for the
+ * WINDOW_SIZE sequence numbers below it. Sequence numbers which fell out
+ * of the window are considered as seen: a packet which arrives that late
+ * is treated as a duplicate.
+ *
+ * @ingroup utils
+ */
+class SequenceWindow
+{
+public:
+	/** @brief Number of sequence numbers below the highest one which are tracked.*/
+	enum { WINDOW_SIZE = 64 };
+
+protected:
+	/** @brief Highest sequence number seen.*/
+	unsigned long highest;
+	/** @brief Bit i is set if sequence number highest-1-i has been seen.*/
+	uint64        seenBelow;
+	/** @brief True as soon as any sequence number has been seen.*/
+	bool          started;
+
+public:
+	SequenceWindow(): highest(0), seenBelow(0), started(false) {}
+
+	/** @brief Returns true if the passed sequence number has been seen (or is too old).*/
+	bool isSeen(unsigned long seqNum) const {
+		if (!started || seqNum > highest)
+			return false;
+		if (seqNum == highest)
+			return true;
+
+		const unsigned long distance = highest - seqNum;
+		if (distance > WINDOW_SIZE)
+			return true;
+		return (seenBelow >> (distance - 1)) & 1;
+	}
+
+	/**
+	 * @brief Marks the passed sequence number as seen, returns false if
+	 * it had already been seen (or is too old).
+	 */
+	bool accept(unsigned long seqNum) {
+		if (!started) {
+			started   = true;
+			highest   = seqNum;
+			seenBelow = 0;
+			return true;
+		}
+		if (seqNum > highest) {
+			const unsigned long shift = seqNum - highest;
+			if (shift > WINDOW_SIZE) {
+				seenBelow = 0;
+			} else {
+				// the old highest becomes bit shift-1
+				seenBelow = (shift == WINDOW_SIZE) ? 0 : (seenBelow << shift);
+				seenBelow |= static_cast<uint64>(1) << (shift - 1);
+			}
+			highest = seqNum;
+			return true;
+		}
+		if (isSeen(seqNum))
+			return false;
+
+		seenBelow |= static_cast<uint64>(1) << (highest - seqNum - 1);
+		return true;
+	}
+
+	/** @brief Returns the highest sequence number seen.*/
+	unsigned long getHighest() const { return highest; }
+};
+
+#endif /* SEQUENCEWINDOW_H_ */
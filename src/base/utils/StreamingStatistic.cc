@@ -0,0 +1,80 @@
+/***************************************************************************
+ * file:        StreamingStatistic.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************/
+#include "StreamingStatistic.h"
+
+#include <sstream>
+
+StreamingStatistic::StreamingStatistic(const char* name, int mode):
+	name(name ? name : ""), mode(NONE), vector(NULL), histogram(name), digest()
+{
+	setMode(mode);
+}
+
+StreamingStatistic::~StreamingStatistic()
+{
+	delete vector;
+}
+
+void StreamingStatistic::setName(const char* newName)
+{
+	name = newName ? newName : "";
+	histogram.setName(newName);
+	if (vector)
+		vector->setName(newName);
+}
+
+void StreamingStatistic::setMode(int newMode)
+{
+	mode = newMode;
+	if ((mode & VECTOR) && vector == NULL) {
+		vector = new cOutVector(name.empty() ? NULL : name.c_str());
+	} else if (!(mode & VECTOR) && vector != NULL) {
+		delete vector;
+		vector = NULL;
+	}
+}
+
+int StreamingStatistic::parseMode(const std::string& modes)
+{
+	int              result = NONE;
+	cStringTokenizer tokenizer(modes.c_str(), " ,");
+
+	while (tokenizer.hasMoreTokens()) {
+		const std::string word = tokenizer.nextToken();
+		if (word == "vector")
+			result |= VECTOR;
+		else if (word == "histogram")
+			result |= HISTOGRAM;
+		else if (word == "quantiles")
+			result |= QUANTILES;
+		else if (word != "none")
+			opp_error("Unknown statistic recording mode \"%s\" (expected vector, histogram, quantiles or none).", word.c_str());
+	}
+	return result;
+}
+
+void StreamingStatistic::recordSummary()
+{
+	if ((mode & HISTOGRAM) && histogram.getCount() > 0) {
+		histogram.recordAs(name.c_str());
+	}
+	if ((mode & QUANTILES) && digest.getCount() > 0) {
+		static const int percents[] = { 1, 5, 25, 50, 75, 95, 99 };
+		cComponent* const owner = simulation.getContextComponent();
+
+		for (size_t i = 0; i < sizeof(percents) / sizeof(percents[0]); ++i) {
+			std::ostringstream scalarName;
+			scalarName << name << ".p" << percents[i];
+			owner->recordScalar(scalarName.str().c_str(), digest.quantile(percents[i] / 100.0));
+		}
+	}
+}
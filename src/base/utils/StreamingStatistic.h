@@ -0,0 +1,126 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        StreamingStatistic.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: per value statistic recorded as vector and/or summaries
+ ***************************************************************************/
+
+#ifndef STREAMINGSTATISTIC_H_
+#define STREAMINGSTATISTIC_H_
+
+#include <string>
+
+#include "MiXiMDefs.h"
+#include "TDigest.h"
+
+/**
+ * @brief Statistic of a value recorded many times (e.g. once per frame or
+ * pulse), which is written as an output vector and/or summarized.
+ *
+ * Meant as replacement for a cOutVector whose files would become too
+ * large. The recording mode is a combination of:
+ * - VECTOR: every value is recorded to the output vector "name".
+ * - HISTOGRAM: a fixed bin histogram (cDoubleHistogram) is recorded as
+ *   statistic "name" by recordSummary().
+ * - QUANTILES: the quantiles 1%, 5%, 25%, 50%, 75%, 95% and 99% are
+ *   estimated in constant memory (TDigest) and recorded as scalars
+ *   "name.p1" ... "name.p99" by recordSummary().
+ *
+ * The output vector is only created in VECTOR mode. The default mode is
+ * HISTOGRAM | QUANTILES, so every value is only written out if VECTOR is
+ * selected explicitly.
+ *
+ * @ingroup utils
+ */
+class MIXIM_API StreamingStatistic
+{
+private:
+	/** @brief Copy constructor is not allowed.*/
+	StreamingStatistic(const StreamingStatistic&);
+	/** @brief Assignment operator is not allowed.*/
+	StreamingStatistic& operator=(const StreamingStatistic&);
+
+public:
+	/** @brief Recording modes, can be combined.*/
+	enum Mode {
+		NONE      = 0,
+		VECTOR    = 1,
+		HISTOGRAM = 2,
+		QUANTILES = 4
+	};
+
+protected:
+	std::string       name;
+	int               mode;
+	/** @brief The output vector, only created in VECTOR mode.*/
+	cOutVector*       vector;
+	cDoubleHistogram  histogram;
+	TDigest           digest;
+
+public:
+	explicit StreamingStatistic(const char* name = NULL, int mode = HISTOGRAM | QUANTILES);
+	~StreamingStatistic();
+
+	void setName(const char* name);
+	const char* getName() const { return name.c_str(); }
+
+	/** @brief Sets the recording mode, only allowed before the first value is recorded.*/
+	void setMode(int mode);
+	int getMode() const { return mode; }
+
+	/** @brief Sets the number of histogram bins, only allowed before the first value is recorded.*/
+	void setNumBins(int nbBins) { histogram.setNumCells(nbBins); }
+
+	/**
+	 * @brief Parses a mode string of space or comma separated words "vector",
+	 * "histogram", "quantiles" (or "none").
+	 */
+	static int parseMode(const std::string& modes);
+
+	/**
+	 * @brief Sets the mode from the parameter "<name>Recording" of a decider
+	 * or analogue model parameter map, if present.
+	 */
+	template<class ParameterMap>
+	void initFromMap(const ParameterMap& params) {
+		typename ParameterMap::const_iterator it = params.find(name + "Recording");
+		if (it != params.end())
+			setMode(parseMode(typename ParameterMap::mapped_type(it->second).stringValue()));
+	}
+
+	/** @brief Records a value at the current simulation time.*/
+	void record(double value) {
+		if (vector)
+			vector->record(value);
+		collect(value);
+	}
+
+	/** @brief Records a value at the passed time.*/
+	void recordWithTimestamp(simtime_t_cref time, double value) {
+		if (vector)
+			vector->recordWithTimestamp(time, value);
+		collect(value);
+	}
+
+	/**
+	 * @brief Records the histogram and quantiles of all values so far for
+	 * the current context module, call it from finish().
+	 */
+	void recordSummary();
+
+protected:
+	void collect(double value) {
+		if (mode & HISTOGRAM)
+			histogram.collect(value);
+		if (mode & QUANTILES)
+			digest.add(value);
+	}
+};
+
+#endif /* STREAMINGSTATISTIC_H_ */
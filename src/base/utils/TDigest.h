@@ -0,0 +1,143 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        TDigest.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: streaming quantile estimation in constant memory
+ ***************************************************************************/
+
+#ifndef TDIGEST_H_
+#define TDIGEST_H_
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+
+/**
+ * @brief Estimates quantiles of a stream of values in constant memory
+ * (merging t-digest by T. Dunning).
+ *
+ * The values are summarized by weighted centroids. Centroids near the
+ * median may hold many values, centroids in the tails only few, so the
+ * extreme quantiles are estimated most accurately. New values are
+ * buffered and merged into the centroids in sorted batches, so adding a
+ * value costs amortized O(log(bufferSize)).
+ *
+ * @ingroup utils
+ */
+class TDigest
+{
+protected:
+	struct Centroid {
+		double mean;
+		double weight;
+
+		Centroid(double m = 0, double w = 0): mean(m), weight(w) {}
+		bool operator<(const Centroid& other) const { return mean < other.mean; }
+	};
+
+	/** @brief Maximum number of centroids is about 2*compression.*/
+	double                compression;
+	std::vector<Centroid> centroids;
+	std::vector<Centroid> buffer;
+	size_t                bufferSize;
+	/** @brief Total weight of the centroids and the buffer.*/
+	double                totalWeight;
+	double                minValue;
+	double                maxValue;
+
+	/** @brief Merges the buffered values into the centroids.*/
+	void compress() {
+		if (buffer.empty())
+			return;
+		buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+		std::sort(buffer.begin(), buffer.end());
+		centroids.clear();
+
+		Centroid current = buffer.front();
+		double   soFar   = 0;
+		for (size_t i = 1; i < buffer.size(); ++i) {
+			const Centroid& next   = buffer[i];
+			const double    weight = current.weight + next.weight;
+			const double    q      = (soFar + weight / 2) / totalWeight;
+
+			if (weight <= 4 * totalWeight * q * (1 - q) / compression) {
+				current.mean  += (next.mean - current.mean) * next.weight / weight;
+				current.weight = weight;
+			} else {
+				soFar += current.weight;
+				centroids.push_back(current);
+				current = next;
+			}
+		}
+		centroids.push_back(current);
+		buffer.clear();
+	}
+
+public:
+	explicit TDigest(double compression = 100):
+		compression(compression), centroids(), buffer(),
+		bufferSize(static_cast<size_t>(5 * compression)), totalWeight(0),
+		minValue(std::numeric_limits<double>::infinity()),
+		maxValue(-std::numeric_limits<double>::infinity())
+	{}
+
+	/** @brief Adds a value to the summarized stream.*/
+	void add(double value) {
+		buffer.push_back(Centroid(value, 1));
+		totalWeight += 1;
+		if (value < minValue) minValue = value;
+		if (value > maxValue) maxValue = value;
+		if (buffer.size() >= bufferSize)
+			compress();
+	}
+
+	/** @brief Returns the number of added values.*/
+	double getCount() const { return totalWeight; }
+
+	/**
+	 * @brief Returns the estimated q-quantile (0 <= q <= 1) of the added
+	 * values, NaN if there are none.
+	 */
+	double quantile(double q) {
+		compress();
+		if (centroids.empty())
+			return std::numeric_limits<double>::quiet_NaN();
+		if (q <= 0) return minValue;
+		if (q >= 1) return maxValue;
+
+		const double target = q * totalWeight;
+		// position of the center of centroid i in the sorted stream
+		double center = centroids.front().weight / 2;
+		if (target <= center) {
+			return minValue + (centroids.front().mean - minValue) * target / center;
+		}
+		for (size_t i = 0; i + 1 < centroids.size(); ++i) {
+			const double nextCenter = center + (centroids[i].weight + centroids[i + 1].weight) / 2;
+			if (target < nextCenter) {
+				const double t = (target - center) / (nextCenter - center);
+				return centroids[i].mean + t * (centroids[i + 1].mean - centroids[i].mean);
+			}
+			center = nextCenter;
+		}
+		const double rest = totalWeight - center;
+		return centroids.back().mean + (maxValue - centroids.back().mean) * (target - center) / rest;
+	}
+
+	/** @brief Forgets all values.*/
+	void clear() {
+		centroids.clear();
+		buffer.clear();
+		totalWeight = 0;
+		minValue    = std::numeric_limits<double>::infinity();
+		maxValue    = -std::numeric_limits<double>::infinity();
+	}
+};
+
+#endif /* TDIGEST_H_ */
@@ -0,0 +1,215 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        TimingWheel.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: timing wheel of elements ordered by their due time
+ ***************************************************************************/
+
+#ifndef TIMINGWHEEL_H_
+#define TIMINGWHEEL_H_
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Priority queue of elements ordered by their due time, for modules
+ * which drive many pending timeouts from one self message.
+ *
+ * The wheel has "nbSlots" slots of "granularity" seconds each. Elements due
+ * within the covered range (nbSlots * granularity from the current slot)
+ * are put into the slot of their due time, later ones into an overflow
+ * level which is only searched again when the wheel turned far enough for
+ * its earliest element. Insertion is O(1). The search for the earliest
+ * element resumes at the first slot which may hold elements, so every
+ * empty slot is skipped once per turn of the wheel (unless an insertion
+ * lands before it again); within the found slot, or the overflow level
+ * while the wheel is empty, the search is linear in its elements.
+ *
+ * Elements with the same due time are returned in insertion order (like
+ * a std::multimap). Elements must not be due before the last popped one.
+ *
+ * @ingroup utils
+ */
+template<class T>
+class TimingWheel
+{
+public:
+	typedef size_t size_type;
+
+protected:
+	/** @brief One element with its due time and insertion number.*/
+	struct Entry {
+		simtime_t     time;
+		unsigned long order;
+		T             value;
+
+		Entry(): time(), order(0), value() {}
+		Entry(simtime_t_cref t, unsigned long o, const T& v): time(t), order(o), value(v) {}
+
+		bool before(const Entry& other) const {
+			return time < other.time || (time == other.time && order < other.order);
+		}
+	};
+	typedef std::vector<Entry> Slot;
+
+	/** @brief The slots of the wheel, slot (n % nbSlots) holds the elements of slot number n.*/
+	std::vector<Slot> slots;
+	/** @brief Elements due after the range covered by the wheel.*/
+	Slot              overflow;
+	/** @brief Earliest slot number of the elements in the overflow level.*/
+	int64             overflowFirst;
+	/** @brief Length of a slot.*/
+	simtime_t         granularity;
+	/** @brief Number of the current slot, the wheel covers [current, current + nbSlots).*/
+	int64             current;
+	/** @brief The slots in [current, firstSlot) are empty.*/
+	int64             firstSlot;
+	size_type         count;
+	unsigned long     nextOrder;
+
+protected:
+	int64 slotNumber(simtime_t_cref time) const {
+		return static_cast<int64>(SIMTIME_DBL(time) / SIMTIME_DBL(granularity));
+	}
+
+	Slot& slotOf(int64 n) {
+		return slots[static_cast<size_type>(n % static_cast<int64>(slots.size()))];
+	}
+
+	void place(const Entry& entry) {
+		int64 n = slotNumber(entry.time);
+		if (n < current)
+			n = current;
+		if (n >= current + static_cast<int64>(slots.size())) {
+			if (overflow.empty() || n < overflowFirst)
+				overflowFirst = n;
+			overflow.push_back(entry);
+		} else {
+			slotOf(n).push_back(entry);
+			if (n < firstSlot)
+				firstSlot = n;
+		}
+	}
+
+	/** @brief Moves the overflow elements which are now covered by the wheel into it.*/
+	void cascade() {
+		if (overflow.empty() || overflowFirst >= current + static_cast<int64>(slots.size()))
+			return;
+		Slot pending;
+		pending.swap(overflow);
+		for (typename Slot::const_iterator it = pending.begin(); it != pending.end(); ++it)
+			place(*it);
+	}
+
+	/**
+	 * @brief Returns the slot holding the earliest element and the index of
+	 * that element in it.
+	 */
+	Slot* findEarliest(size_type& index) {
+		assert(count > 0);
+		const int64 end = current + static_cast<int64>(slots.size());
+		if (firstSlot < current)
+			firstSlot = current;
+		while (firstSlot < end && slotOf(firstSlot).empty())
+			++firstSlot;
+		Slot* slot = (firstSlot < end) ? &slotOf(firstSlot) : &overflow;
+
+		index = 0;
+		for (size_type i = 1; i < slot->size(); ++i) {
+			if ((*slot)[i].before((*slot)[index]))
+				index = i;
+		}
+		return slot;
+	}
+
+public:
+	explicit TimingWheel(simtime_t_cref granularity = 1, size_type nbSlots = 256):
+		slots(nbSlots), overflow(), overflowFirst(0), granularity(granularity),
+		current(0), firstSlot(0), count(0), nextOrder(0)
+	{
+		assert(nbSlots > 0);
+		assert(granularity > 0);
+	}
+
+	/**
+	 * @brief Sets the slot length and number of slots, only allowed while
+	 * the wheel is empty.
+	 */
+	void setGeometry(simtime_t_cref newGranularity, size_type nbSlots) {
+		assert(count == 0);
+		assert(nbSlots > 0);
+		assert(newGranularity > 0);
+		granularity = newGranularity;
+		slots.assign(nbSlots, Slot());
+		clear();
+	}
+
+	size_type size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	/** @brief Inserts an element which is due at "time".*/
+	void insert(simtime_t_cref time, const T& value) {
+		place(Entry(time, nextOrder++, value));
+		++count;
+	}
+
+	/** @brief Returns the due time of the earliest element.*/
+	simtime_t getFirstTime() {
+		size_type index;
+		Slot* slot = findEarliest(index);
+		return (*slot)[index].time;
+	}
+
+	/** @brief Returns the earliest element.*/
+	const T& front() {
+		size_type index;
+		Slot* slot = findEarliest(index);
+		return (*slot)[index].value;
+	}
+
+	/**
+	 * @brief Removes the earliest element and turns the wheel to its slot.
+	 */
+	T pop_front() {
+		size_type index;
+		Slot* slot = findEarliest(index);
+		const Entry entry = (*slot)[index];
+
+		(*slot)[index] = slot->back();
+		slot->pop_back();
+		--count;
+
+		const int64 n = slotNumber(entry.time);
+		if (n > current) {
+			current = n;
+			cascade();
+		}
+		return entry.value;
+	}
+
+	/**
+	 * @brief Removes all elements, the caller has to free them before.
+	 * The wheel starts over at time zero afterwards.
+	 */
+	void clear() {
+		for (typename std::vector<Slot>::iterator s = slots.begin(); s != slots.end(); ++s)
+			s->clear();
+		overflow.clear();
+		overflowFirst = 0;
+		current       = 0;
+		firstSlot     = 0;
+		count         = 0;
+		nextOrder     = 0;
+	}
+};
+
+#endif /* TIMINGWHEEL_H_ */
@@ -0,0 +1,260 @@
+/***************************************************************************
+ * file:        TraceFile.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************/
+#include "TraceFile.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+	const char          MAGIC[4]       = { 'M', 'X', 'T', 'R' };
+	const unsigned char FORMAT_VERSION = 1;
+
+	void putVarint(std::string& buf, uint64 value) {
+		while (value >= 0x80) {
+			buf += static_cast<char>((value & 0x7f) | 0x80);
+			value >>= 7;
+		}
+		buf += static_cast<char>(value);
+	}
+
+	uint64 zigzag(int64 value) {
+		return (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63);
+	}
+
+	int64 unzigzag(uint64 value) {
+		return static_cast<int64>(value >> 1) ^ -static_cast<int64>(value & 1);
+	}
+
+	/** @brief Creates the missing directories of the path, errors show up when the file is opened.*/
+	void createParentDirectories(const std::string& fileName) {
+		std::string::size_type sep = fileName.find_first_of("/\\", 1);
+		for (; sep != std::string::npos; sep = fileName.find_first_of("/\\", sep + 1)) {
+			const std::string dir = fileName.substr(0, sep);
+#ifdef _WIN32
+			_mkdir(dir.c_str());
+#else
+			mkdir(dir.c_str(), 0777);
+#endif
+		}
+	}
+
+	void putDouble(std::string& buf, double value) {
+		uint64 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		for (int i = 0; i < 8; ++i) {
+			buf += static_cast<char>(bits & 0xff);
+			bits >>= 8;
+		}
+	}
+}
+
+TraceFile::FileMap& TraceFile::openFiles()
+{
+	static FileMap files;
+	return files;
+}
+
+TraceFile::TraceFile(const std::string& fileName):
+	out(), fileName(fileName), refCount(0), nextChannelId(0), encodeBuffer()
+{
+	// the result directory is only created by OMNeT++ when it writes the first result
+	createParentDirectories(fileName);
+	out.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!out)
+		opp_error("Could not open trace file %s.", fileName.c_str());
+	out.write(MAGIC, sizeof(MAGIC));
+	out.put(static_cast<char>(FORMAT_VERSION));
+	out.put(static_cast<char>(SimTime::getScaleExp()));
+}
+
+TraceFile::~TraceFile()
+{
+	out.close();
+}
+
+std::string TraceFile::defaultFileName(const std::string& prefix)
+{
+	cConfigurationEx*  config = cSimulation::getActiveSimulation()->getEnvir()->getConfigEx();
+	std::ostringstream name;
+	name << "results/" << config->getVariable("configname") << "-"
+	     << config->getVariable("runnumber") << "-" << prefix << ".trace";
+	return name.str();
+}
+
+TraceFile* TraceFile::acquire(const std::string& fileName)
+{
+	FileMap&          files = openFiles();
+	FileMap::iterator it    = files.find(fileName);
+	TraceFile*        file;
+
+	if (it == files.end()) {
+		file = new TraceFile(fileName);
+		files[fileName] = file;
+	} else {
+		file = it->second;
+	}
+	++file->refCount;
+	return file;
+}
+
+void TraceFile::release()
+{
+	assert(refCount > 0);
+	if (--refCount == 0) {
+		openFiles().erase(fileName);
+		delete this;
+	}
+}
+
+unsigned long TraceFile::declareChannel(const std::string& name)
+{
+	const unsigned long id = nextChannelId++;
+
+	encodeBuffer.clear();
+	encodeBuffer += 'C';
+	putVarint(encodeBuffer, id);
+	putVarint(encodeBuffer, name.size());
+	encodeBuffer += name;
+	out.write(encodeBuffer.data(), encodeBuffer.size());
+	return id;
+}
+
+void TraceFile::writeBlock(unsigned long channelId,
+                           const std::vector<int64>& rawTimes,
+                           const std::vector<double>& values)
+{
+	assert(rawTimes.size() == values.size());
+	if (rawTimes.empty())
+		return;
+
+	encodeBuffer.clear();
+	encodeBuffer.reserve(2 + 10 * rawTimes.size() + 8 * values.size());
+	encodeBuffer += 'B';
+	putVarint(encodeBuffer, channelId);
+	putVarint(encodeBuffer, rawTimes.size());
+
+	int64 last = 0;
+	for (std::vector<int64>::const_iterator it = rawTimes.begin(); it != rawTimes.end(); ++it) {
+		putVarint(encodeBuffer, zigzag(*it - last));
+		last = *it;
+	}
+	for (std::vector<double>::const_iterator it = values.begin(); it != values.end(); ++it) {
+		putDouble(encodeBuffer, *it);
+	}
+	out.write(encodeBuffer.data(), encodeBuffer.size());
+}
+
+void TraceChannel::open(const std::string& fileName, const std::string& name, size_t blockSize)
+{
+	close();
+	assert(blockSize > 0);
+	this->blockSize = blockSize;
+	file            = TraceFile::acquire(fileName);
+	channelId       = file->declareChannel(name);
+	rawTimes.reserve(blockSize);
+	values.reserve(blockSize);
+}
+
+void TraceChannel::close()
+{
+	if (file == NULL)
+		return;
+	flush();
+	file->release();
+	file = NULL;
+}
+
+void TraceChannel::flush()
+{
+	if (file == NULL || rawTimes.empty())
+		return;
+	file->writeBlock(channelId, rawTimes, values);
+	rawTimes.clear();
+	values.clear();
+}
+
+bool TraceFileReader::open(const std::string& fileName)
+{
+	channels.clear();
+	in.close();
+	in.clear();
+	in.open(fileName.c_str(), std::ios::in | std::ios::binary);
+
+	char header[6];
+	if (!in.read(header, sizeof(header)) || memcmp(header, MAGIC, sizeof(MAGIC)) != 0
+	    || static_cast<unsigned char>(header[4]) != FORMAT_VERSION)
+		return false;
+	scaleExp = static_cast<signed char>(header[5]);
+	return true;
+}
+
+bool TraceFileReader::readVarint(uint64& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		const int c = in.get();
+		if (c == EOF)
+			return false;
+		value |= static_cast<uint64>(c & 0x7f) << shift;
+		if ((c & 0x80) == 0)
+			return true;
+	}
+	return false;
+}
+
+bool TraceFileReader::readBlock(std::string& channel, std::vector<int64>& rawTimes, std::vector<double>& values)
+{
+	for (int tag = in.get(); tag != EOF; tag = in.get()) {
+		uint64 id, length;
+		if (!readVarint(id) || !readVarint(length))
+			return false;
+
+		if (tag == 'C') {
+			std::string name(static_cast<size_t>(length), '\0');
+			if (length > 0 && !in.read(&name[0], static_cast<std::streamsize>(length)))
+				return false;
+			channels[static_cast<unsigned long>(id)] = name;
+		} else if (tag == 'B') {
+			channel = channels[static_cast<unsigned long>(id)];
+			rawTimes.resize(static_cast<size_t>(length));
+			values.resize(static_cast<size_t>(length));
+
+			int64 last = 0;
+			for (size_t i = 0; i < rawTimes.size(); ++i) {
+				uint64 delta;
+				if (!readVarint(delta))
+					return false;
+				last += unzigzag(delta);
+				rawTimes[i] = last;
+			}
+			for (size_t i = 0; i < values.size(); ++i) {
+				unsigned char bytes[8];
+				if (!in.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+					return false;
+				uint64 bits = 0;
+				for (int b = 7; b >= 0; --b)
+					bits = (bits << 8) | bytes[b];
+				memcpy(&values[i], &bits, sizeof(bits));
+			}
+			return true;
+		} else {
+			return false;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,183 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        TraceFile.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: buffered binary trace files for high volume debug traces
+ ***************************************************************************/
+
+#ifndef TRACEFILE_H_
+#define TRACEFILE_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+#include "MiXiMDefs.h"
+
+/**
+ * @brief Binary file holding the (time, value) samples of any number of
+ * trace channels, shared by all channels writing to the same file name.
+ *
+ * Meant for traces which are far too large for cOutVector files (e.g.
+ * every single UWB pulse). The samples are written in blocks of one
+ * channel, column by column: first the times as variable length encoded
+ * differences of raw simulation time values, then the values as 8 byte
+ * doubles. So a block of regularly spaced pulses needs little more than
+ * 9 bytes per sample.
+ *
+ * File format (all integers little endian):
+ * - header: "MXTR", version byte (1), simulation time scale exponent byte
+ * - channel declaration: 'C', varint channel id, varint name length, name
+ * - block: 'B', varint channel id, varint sample count, sample count
+ *   zigzag varint time differences (the first one relative to zero),
+ *   sample count doubles
+ *
+ * Use TraceChannel to write and TraceFileReader to read such files.
+ *
+ * @ingroup utils
+ */
+class MIXIM_API TraceFile
+{
+private:
+	/** @brief Copy constructor is not allowed.*/
+	TraceFile(const TraceFile&);
+	/** @brief Assignment operator is not allowed.*/
+	TraceFile& operator=(const TraceFile&);
+
+protected:
+	typedef std::map<std::string, TraceFile*> FileMap;
+
+	std::ofstream out;
+	std::string   fileName;
+	/** @brief Number of channels using this file.*/
+	int           refCount;
+	unsigned long nextChannelId;
+	/** @brief Reused buffer to encode a block in.*/
+	std::string   encodeBuffer;
+
+	/** @brief The open files, by file name.*/
+	static FileMap& openFiles();
+
+	explicit TraceFile(const std::string& fileName);
+	~TraceFile();
+
+public:
+	/** @brief Returns "results/<config name>-<run number>-<prefix>.trace", like the names of the result files.*/
+	static std::string defaultFileName(const std::string& prefix);
+
+	/**
+	 * @brief Opens the file with the passed name (or returns the open one), call release() when done.
+	 *
+	 * Missing directories of the path are created.
+	 */
+	static TraceFile* acquire(const std::string& fileName);
+
+	/** @brief Releases a file returned by acquire(), the last release closes it.*/
+	void release();
+
+	/** @brief Registers a channel of the passed name and returns its id.*/
+	unsigned long declareChannel(const std::string& name);
+
+	/** @brief Appends a block of samples of the passed channel.*/
+	void writeBlock(unsigned long channelId,
+	                const std::vector<int64>& rawTimes,
+	                const std::vector<double>& values);
+
+	const std::string& getFileName() const { return fileName; }
+};
+
+/**
+ * @brief One trace channel of a module, buffers its samples and writes
+ * them to a TraceFile in large blocks.
+ *
+ * A channel which has not been opened ignores record() calls after a
+ * single pointer test, so call sites can stay in place when tracing is
+ * switched off. The buffer belongs to the channel only, no locking is
+ * involved.
+ *
+ * @ingroup utils
+ */
+class MIXIM_API TraceChannel
+{
+private:
+	/** @brief Copy constructor is not allowed.*/
+	TraceChannel(const TraceChannel&);
+	/** @brief Assignment operator is not allowed.*/
+	TraceChannel& operator=(const TraceChannel&);
+
+public:
+	/** @brief Default number of samples written per block.*/
+	enum { DEFAULT_BLOCK_SIZE = 65536 };
+
+protected:
+	TraceFile*          file;
+	unsigned long       channelId;
+	size_t              blockSize;
+	std::vector<int64>  rawTimes;
+	std::vector<double> values;
+
+public:
+	TraceChannel(): file(NULL), channelId(0), blockSize(DEFAULT_BLOCK_SIZE), rawTimes(), values() {}
+	~TraceChannel() { close(); }
+
+	/** @brief Starts tracing to the channel "name" of the passed file.*/
+	void open(const std::string& fileName, const std::string& name, size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+	/** @brief Writes the buffered samples and stops tracing.*/
+	void close();
+
+	/** @brief Returns true if the channel has been opened.*/
+	bool isEnabled() const { return file != NULL; }
+
+	/** @brief Stores one sample, does nothing if the channel is not open.*/
+	void record(simtime_t_cref time, double value) {
+		if (file == NULL)
+			return;
+		rawTimes.push_back(SIMTIME_RAW(time));
+		values.push_back(value);
+		if (rawTimes.size() >= blockSize)
+			flush();
+	}
+
+	/** @brief Writes the buffered samples to the file.*/
+	void flush();
+};
+
+/**
+ * @brief Reads the blocks of a file written by TraceChannel.
+ *
+ * @ingroup utils
+ */
+class MIXIM_API TraceFileReader
+{
+protected:
+	std::ifstream                          in;
+	int                                    scaleExp;
+	std::map<unsigned long, std::string>   channels;
+
+	bool readVarint(uint64& value);
+
+public:
+	TraceFileReader(): in(), scaleExp(0), channels() {}
+
+	/** @brief Opens the passed file and checks its header, returns false on failure.*/
+	bool open(const std::string& fileName);
+
+	/** @brief Returns the simulation time scale exponent the file was written with.*/
+	int getScaleExp() const { return scaleExp; }
+
+	/**
+	 * @brief Reads the next block into the passed channel name and columns,
+	 * returns false at the end of the file or on a format error.
+	 */
+	bool readBlock(std::string& channel, std::vector<int64>& rawTimes, std::vector<double>& values);
+};
+
+#endif /* TRACEFILE_H_ */
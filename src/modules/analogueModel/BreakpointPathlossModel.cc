@@ -97,8 +97,9 @@ void BreakpointPathlossModel::filterSignal(airframe_ptr_t frame, const Coord& se
 	Signal& signal = frame->getSignal();
 
 	/** Calculate the distance factor */
-	double distance = useTorus ? receiverPos.sqrTorusDist(sendersPos, playgroundSize)
-								  : receiverPos.sqrdist(sendersPos);
+	const PlainCoord receiver(receiverPos);
+	double distance = useTorus ? receiver.sqrTorusDist(sendersPos, playgroundSize)
+								  : receiver.sqrdist(sendersPos);
 	distance = sqrt(distance);
 	debugEV << "distance is: " << distance << endl;
 
@@ -5,6 +5,7 @@
 
 #include "MiXiMDefs.h"
 #include "AnalogueModel.h"
+#include "PlainCoord.h"
 
 /**
  * @brief Basic implementation of a BreakpointPathlossModel.
@@ -39,7 +40,7 @@ protected:
     bool useTorus;
 
     /** @brief The size of the playground.*/
-    Coord playgroundSize;
+    PlainCoord playgroundSize;
 
     /** @brief Whether debug messages should be displayed. */
     bool debug;
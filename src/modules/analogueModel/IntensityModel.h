@@ -27,6 +27,7 @@
 #include "Mapping.h"
 #include "MiXiMAirFrame.h"
 #include "FWMath.h"
+#include "PlainCoord.h"
 
 /**
  * @brief TODO: Short description for this AnalogueModel
@@ -45,7 +46,7 @@ class MIXIM_API IntensityModel : public AnalogueModel {
 
             // Determine distance between sender and receiver
             assert(s.getReceptionStart() == simTime());
-            double distance = sendersPos.distance(receiverPos);
+            double distance = PlainCoord(sendersPos).distance(receiverPos);
 
             Argument arg;
             attMapping->setValue(arg, 4 * M_PI * pow(distance, 2));
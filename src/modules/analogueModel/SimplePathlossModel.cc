@@ -95,8 +95,9 @@ void SimplePathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sender
 	Signal& signal = frame->getSignal();
 
 	/** Calculate the distance factor */
-	double sqrDistance = useTorus ? receiverPos.sqrTorusDist(sendersPos, playgroundSize)
-								  : receiverPos.sqrdist(sendersPos);
+	const PlainCoord receiver(receiverPos);
+	double sqrDistance = useTorus ? receiver.sqrTorusDist(sendersPos, playgroundSize)
+								  : receiver.sqrdist(sendersPos);
 
 	splmEV << "sqrdistance is: " << sqrDistance << endl;
 
@@ -144,10 +145,10 @@ double SimplePathlossModel::calcPathloss(const Coord& receiverPos, const Coord&
 
 	if (useTorus)
 	{
-		sqrdistance = receiverPos.sqrTorusDist(sendersPos, playgroundSize);
+		sqrdistance = PlainCoord(receiverPos).sqrTorusDist(sendersPos, playgroundSize);
 	} else
 	{
-		sqrdistance = receiverPos.sqrdist(sendersPos);
+		sqrdistance = PlainCoord(receiverPos).sqrdist(sendersPos);
 	}
 
 	splmEV << "sqrdistance is: " << sqrdistance << endl;
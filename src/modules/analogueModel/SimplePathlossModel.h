@@ -7,6 +7,7 @@
 #include "AnalogueModel.h"
 #include "Mapping.h"
 #include "BaseWorldUtility.h"
+#include "PlainCoord.h"
 
 class SimplePathlossModel;
 
@@ -105,7 +106,7 @@ protected:
 	bool useTorus;
 
 	/** @brief The size of the playground.*/
-	Coord playgroundSize;
+	PlainCoord playgroundSize;
 
 	/** @brief Whether debug messages should be displayed. */
 	bool debug;
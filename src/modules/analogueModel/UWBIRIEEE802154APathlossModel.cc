@@ -24,7 +24,9 @@
 #include <limits>
 
 #include "IEEE802154A.h"
+#include "UWBIRPulseMapping.h"
 #include "MiXiMAirFrame.h"
+#include "PlainCoord.h"
 
 const double UWBIRIEEE802154APathlossModel::PL0 = 0.000040738; // -43.9 dB
 const double UWBIRIEEE802154APathlossModel::pathloss_exponent = 1.79;
@@ -212,14 +214,23 @@ bool UWBIRIEEE802154APathlossModel::initFromMap(const ParameterMap& params) {
         doShadowing = false;
     }
 
+    pathlosses.initFromMap(params);
     return AnalogueModel::initFromMap(params) && bInitSuccess;
 }
 
+void UWBIRIEEE802154APathlossModel::finish()
+{
+    pathlosses.recordSummary();
+}
+
 void UWBIRIEEE802154APathlossModel::filterSignal(airframe_ptr_t frame, const Coord& sendersPos, const Coord& receiverPos)
 {
     Signal& signal = frame->getSignal();
     // We create a new "fake" txPower to add multipath taps
     // and then attenuation is applied to all pulses.
+    // Note: the echoes are written as key points into a TimeMapping<Linear>,
+    // so each receiver still holds every pulse and echo of the frame. Only
+    // the sender side (UWBIRPulseMapping) is generated on demand.
 
     // (1) Power Delay Profile realization
     using std::max;
@@ -232,28 +243,37 @@ void UWBIRIEEE802154APathlossModel::filterSignal(airframe_ptr_t frame, const Coo
     // Choose block shadowing
     S = powf(10.,(normal(0, cfg.sigma_s)/10.));
 
-    // Loop on each value of the original mapping and generate multipath echoes
-    ConstMappingIterator* iter = txPower->createConstIterator();
-
-    while (iter->inRange()) {
-        // generate echoes for each non zero value
-        if (iter->getValue() != 0) {
-        	// give the pulse start position
-            addEchoes(iter->getPosition().getTime() - IEEE802154A::mandatory_pulse/2);
+    const UWBIRPulseMapping* pulses = dynamic_cast<const UWBIRPulseMapping*>(txPower);
+    if (pulses) {
+        // generate multipath echoes for each pulse, the pulse peaks are computed directly
+        const size_t nbPulses = pulses->getNbPulses();
+        for (size_t pulse = 0; pulse < nbPulses; ++pulse) {
+            addEchoes(pulses->getPulsePeak(pulse) - IEEE802154A::mandatory_pulse/2);
         }
-        if (!iter->hasNext()) {
-            break;
+    } else {
+        // Loop on each value of the original mapping and generate multipath echoes
+        ConstMappingIterator* iter = txPower->createConstIterator();
+
+        while (iter->inRange()) {
+            // generate echoes for each non zero value
+            if (iter->getValue() != 0) {
+                // give the pulse start position
+                addEchoes(iter->getPosition().getTime() - IEEE802154A::mandatory_pulse/2);
+            }
+            if (!iter->hasNext()) {
+                break;
+            }
+            iter->next();
         }
-        iter->next();
+        delete iter;
     }
-    delete iter;
     delete pulsesIter;
     signal.setTransmissionPower(newTxPower);
 
 
     // Total radiated power Prx at that distance  [W]
     //double attenuation = 0.5 * ntx * nrx * cfg.PL0 / pow(distance / d0, cfg.n);
-    double attenuation = getPathloss(fc, BW, receiverPos.distance(sendersPos));
+    double attenuation = getPathloss(fc, BW, PlainCoord(receiverPos).distance(sendersPos));
     pathlosses.record(attenuation);
     // Power intensity I at that distance [W/m²]
     //attenuation = attenuation /(4*PI*pow(distance, cfg.n));
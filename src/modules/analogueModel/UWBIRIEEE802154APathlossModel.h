@@ -24,6 +24,7 @@
 #include "MiXiMDefs.h"
 #include "AnalogueModel.h"
 #include "SimpleTimeConstMapping.h"
+#include "StreamingStatistic.h"
 
 /**
  * @brief This class implements the IEEE 802.15.4A Channel Model[1] in the MiXiM
@@ -106,6 +107,9 @@ public:
 
     virtual ~UWBIRIEEE802154APathlossModel() {}
 
+    /** @brief Records the summary of the pathloss statistic.*/
+    virtual void finish();
+
     /*
      * @brief Applies the model to an incoming AirFrame's Signal.
      */
@@ -187,7 +191,7 @@ protected:
     static const double nrx;
 
     TimeMapping<Linear>* newTxPower;
-    ConstMapping* txPower;
+    const ConstMapping* txPower;
     Argument arg;
     MappingIterator* pulsesIter;
     // number of clusters
@@ -204,7 +208,8 @@ protected:
     double averagePower; // statistics counter (useful for model validation, should converges towards 1)
     long nbCalls;
     cOutVector averagePowers;
-    cOutVector pathlosses;  // outputs computed pathlosses. Allows to compute Eb = Epulse*pathloss for Eb/N0 computations. (N0 is the noise sampled by the receiver)
+    StreamingStatistic pathlosses;  // outputs computed pathlosses. Allows to compute Eb = Epulse*pathloss for Eb/N0 computations. (N0 is the noise sampled by the receiver)
+                                    // recording mode set by the parameter "pathlossRecording" (see StreamingStatistic)
 
     /*
      * Generates taps for the considered pulse, with the current channel parameters
@@ -21,6 +21,7 @@
 
 #include "BaseWorldUtility.h"
 #include "MiXiMAirFrame.h"
+#include "PlainCoord.h"
 
 //const double UWBIRStochasticPathlossModel::Gtx = 0.9, UWBIRStochasticPathlossModel::Grx = 0.9, UWBIRStochasticPathlossModel::ntx = 0.9, UWBIRStochasticPathlossModel::nrx = 0.9;
 const double UWBIRStochasticPathlossModel::Gtx = 1, UWBIRStochasticPathlossModel::Grx = 1, UWBIRStochasticPathlossModel::ntx = 1, UWBIRStochasticPathlossModel::nrx = 1;
@@ -120,7 +121,7 @@ void UWBIRStochasticPathlossModel::filterSignal(airframe_ptr_t frame, const Coor
 		S = n2 * sigma;
 
 		// Determine distance between sender and receiver
-		double distance    = receiverPos.distance(sendersPos);
+		double distance    = PlainCoord(receiverPos).distance(sendersPos);
 		/*
 		 srcPosX.record(senderPos.x);
 		 srcPosY.record(senderPos.y);
@@ -38,11 +38,14 @@ void BMacLayer::initialize(int stage)
 		BaseLayer::catDroppedPacketSignal.initialize();
 
 		queueLength   = hasPar("queueLength")   ? par("queueLength")   : 10;
+		macQueue.setCapacity(queueLength);
 		animation     = hasPar("animation")     ? par("animation")     : true;
 		slotDuration  = hasPar("slotDuration")  ? par("slotDuration")  : 1.;
 		bitrate       = hasPar("bitrate")       ? par("bitrate")       : 15360.;
 		headerLength  = hasPar("headerLength")  ? par("headerLength")  : 10.;
 		checkInterval = hasPar("checkInterval") ? par("checkInterval") : 0.1;
+		preambleDuration = hasPar("preambleDuration") ? par("preambleDuration") : 0.1;
+		ackTimeout    = hasPar("ackTimeout")    ? par("ackTimeout")    : 0.1;
 		txPower       = hasPar("txPower")       ? par("txPower")       : 50.;
 		useMacAcks    = hasPar("useMACAcks")    ? par("useMACAcks")    : false;
 		maxTxAttempts = hasPar("maxTxAttempts") ? par("maxTxAttempts") : 2;
@@ -120,10 +123,9 @@ BMacLayer::~BMacLayer()
 	cancelAndDelete(data_tx_over);
 
 
-	MacQueue::iterator it;
-	for(it = macQueue.begin(); it != macQueue.end(); ++it)
+	for(MacQueue::size_type i = 0; i < macQueue.size(); ++i)
 	{
-		delete (*it);
+		delete macQueue[i];
 	}
 	macQueue.clear();
 }
@@ -221,7 +223,7 @@ void BMacLayer::handleSelfMsg(cMessage *msg)
 
     case INIT:
         if(msg->getKind() == START_TRANSMITTER){
-            scheduleAt(simTime() + 0.1, ready_to_send);
+            scheduleAt(simTime() + preambleDuration, ready_to_send);
             changeDisplayColor(GREEN);
             phy->setRadioState(MiximRadio::TX);
             macState = Tx_SENDING;
@@ -252,7 +254,7 @@ void BMacLayer::handleSelfMsg(cMessage *msg)
             macState = Tx_WAIT_ACK;
             changeDisplayColor(RED);
             phy->setRadioState(MiximRadio::RX);
-            scheduleAt(simTime() + 0.1, time_out);
+            scheduleAt(simTime() + ackTimeout, time_out);
 
             return;
         }
@@ -272,7 +274,7 @@ void BMacLayer::handleSelfMsg(cMessage *msg)
         if(msg->getKind() == TIME_OUT){
             changeDisplayColor(GREEN);
             phy->setRadioState(MiximRadio::TX);
-            scheduleAt(simTime() + 0.1, ready_to_send);
+            scheduleAt(simTime() + preambleDuration, ready_to_send);
             macState = Tx_SENDING;
             return;
         }
@@ -280,7 +282,7 @@ void BMacLayer::handleSelfMsg(cMessage *msg)
     case Tx_SLEEP:
         if(msg->getKind() == WAKE_UP){
 
-            scheduleAt(simTime() + 0.1, ready_to_send);
+            scheduleAt(simTime() + preambleDuration, ready_to_send);
             changeDisplayColor(GREEN);
             phy->setRadioState(MiximRadio::TX);
 
@@ -383,7 +385,7 @@ void BMacLayer::handleLowerControl(cMessage *msg)
  */
 bool BMacLayer::addToQueue(cMessage *msg)
 {
-	if (macQueue.size() >= queueLength) {
+	if (macQueue.full()) {
 		// queue is full, message has to be deleted
 		debugEV << "New packet arrived, but queue is FULL, so new packet is"
 				  " deleted\n";
@@ -19,11 +19,11 @@
 #include <string>
 #include <sstream>
 #include <vector>
-#include <list>
 
 #include "MiXiMDefs.h"
 #include "BaseMacLayer.h"
 #include <DroppedPacket.h>
+#include "BoundedQueue.h"
 
 class MacPkt;
 
@@ -81,7 +81,7 @@ class MIXIM_API BMacLayer : public BaseMacLayer
 		, nicId(-1)
 		, queueLength(0)
 		, animation(false)
-		, slotDuration(0), bitrate(0), checkInterval(0), txPower(0)
+		, slotDuration(0), bitrate(0), checkInterval(0), preambleDuration(0), ackTimeout(0), txPower(0)
 		, useMacAcks(0)
 		, maxTxAttempts(0)
 		, stats(false)
@@ -107,7 +107,7 @@ class MIXIM_API BMacLayer : public BaseMacLayer
     virtual void handleLowerControl(cMessage *msg);
 
   protected:
-    typedef std::list<macpkt_ptr_t> MacQueue;
+    typedef BoundedQueue<macpkt_ptr_t> MacQueue;
 
     /** @brief A queue to store packets from upper layer in case another
 	packet is still waiting for transmission.*/
@@ -208,7 +208,6 @@ class MIXIM_API BMacLayer : public BaseMacLayer
 	int nicId;
 	int nodeId;
 	int dataPeriod;
-	int ack_time_out = 0.2;
 
 	/** @brief The maximum length of the queue */
 	unsigned int queueLength;
@@ -226,6 +225,14 @@ class MIXIM_API BMacLayer : public BaseMacLayer
 	double bitrate;
 	/** @brief The duration of CCA */
 	double checkInterval;
+	/** @brief Duration of the preamble phase in front of every data packet.
+	 *
+	 * The preamble train is not sent preamble by preamble, the radio
+	 * simply stays in TX for the whole phase and a single timer ends it.
+	 */
+	double preambleDuration;
+	/** @brief How long the sender waits for an ACK before it retransmits. */
+	double ackTimeout;
 	/** @brief Transmission power of the node */
 	double txPower;
 	/** @brief Use MAC level acks or not */
@@ -1,10 +1,10 @@
 #ifndef CSMAMAC_LAYER_H
 #define CSMAMAC_LAYER_H
 
-#include <list>
 
 #include "MiXiMDefs.h"
 #include "BaseMacLayer.h"
+#include "BoundedQueue.h"
 
 /**
  * @class CSMAMacLayer
@@ -77,7 +77,7 @@ class MIXIM_API CSMAMacLayer : public BaseMacLayer
 
   protected:
     /** @brief Type for a queue of cPackets.*/
-    typedef std::list<cPacket*> MacQueue;
+    typedef BoundedQueue<cPacket*> MacQueue;
 
     /** @brief MAC states
      *
@@ -11,6 +11,8 @@
 
 #include "LMacLayer.h"
 
+#include <algorithm>
+
 #include "FWMath.h"
 #include "MacToPhyInterface.h"
 #include "LMacPkt_m.h"
@@ -22,6 +24,21 @@ Define_Module( LMacLayer )
 
 const LAddress::L2Type LMacLayer::LMAC_NO_RECEIVER = LAddress::L2Type(-2);
 const LAddress::L2Type LMacLayer::LMAC_FREE_SLOT   = LAddress::L2BROADCAST;
+const int              LMacLayer::MAX_SLOTS;
+
+/** @brief Returns the index of the highest set bit of a non-zero mask.*/
+static inline int highestSetBit(uint64 mask)
+{
+#if defined(__GNUC__)
+	return 63 - __builtin_clzll(mask);
+#else
+	int bit = 0;
+	while (mask >>= 1)
+		++bit;
+	return bit;
+#endif
+}
+
 /**
  * Initialize the of the omnetpp.ini variables in stage 1. In stage
  * two subscribe to the RadioState.
@@ -34,14 +51,20 @@ void LMacLayer::initialize(int stage)
     	BaseLayer::catDroppedPacketSignal.initialize();
 
         queueLength = par("queueLength");
+        // the queue always accepted one packet more than queueLength
+        macQueue.setCapacity(queueLength + 1);
         slotDuration = par("slotDuration");
         bitrate = par("bitrate");
         headerLength = par("headerLength");
         coreEV << "headerLength is: " << headerLength << endl;
         numSlots = par("numSlots");
+        if (numSlots > MAX_SLOTS)
+            opp_error("LMacLayer supports at most %d slots, %d configured.", MAX_SLOTS, numSlots);
         // the first N slots are reserved for mobile nodes to be able to function normally
         reservedMobileSlots = par("reservedMobileSlots");
         txPower = par("txPower");
+        skipFreeSlots = par("skipFreeSlots");
+        fullListenFrames = par("fullListenFrames");
 
         droppedPacket.setReason(DroppedPacket::NONE);
         nicId = getNic()->getId();
@@ -102,9 +125,8 @@ LMacLayer::~LMacLayer() {
     cancelAndDelete(start_lmac);
     cancelAndDelete(send_control);
 
-    MacQueue::iterator it;
-    for(it = macQueue.begin(); it != macQueue.end(); ++it) {
-        delete (*it);
+    for(MacQueue::size_type i = 0; i < macQueue.size(); ++i) {
+        delete macQueue[i];
     }
     macQueue.clear();
 }
@@ -124,8 +146,7 @@ void LMacLayer::handleUpperMsg(cMessage *msg)
     // message has to be queued if another message is waiting to be send
     // or if we are already trying to send another message
 
-    if (macQueue.size() <= queueLength) {
-        macQueue.push_back(mac);
+    if (macQueue.push_back(mac)) {
 	debugEV << "packet put in queue\n  queue size: " << macQueue.size() << " macState: " << macState
 	    << "; mySlot is " << mySlot << "; current slot is " << currSlot << endl;;
 
@@ -171,6 +192,9 @@ void LMacLayer::handleSelfMsg(cMessage *msg)
 				occSlotsDirect[i] = LMAC_FREE_SLOT;
 				occSlotsAway[i]   = LMAC_FREE_SLOT;
 			}
+			occMaskDirect = 0;
+			occMaskAway   = 0;
+			slotsToSkip   = 0;
 
 			if (myId >= reservedMobileSlots)
 				mySlot = ((int) FindModule<>::findHost(this)->getId() ) % (numSlots - reservedMobileSlots);
@@ -194,8 +218,12 @@ void LMacLayer::handleSelfMsg(cMessage *msg)
 	case SLEEP:
 		if(msg->getKind() == LMAC_WAKEUP)
 		{
-			currSlot++;
+			currSlot += 1 + slotsToSkip;
+			if (currSlot >= numSlots)
+				++frameCount;
 			currSlot %= numSlots;
+			slotsToSkip = 0;
+			currSlotStart = simTime();
 			debugEV << "New slot starting - No. " << currSlot << ", my slot is " << mySlot << endl;
 
 			if (mySlot == currSlot)
@@ -224,7 +252,13 @@ void LMacLayer::handleSelfMsg(cMessage *msg)
 				debugEV << "setup phase slot duration:" << 2.f*controlDuration << "while controlduration is" << controlDuration << endl;
 			}
 			else
-				scheduleAt(simTime()+slotDuration, wakeup);
+			{
+				if (skipFreeSlots)
+					slotsToSkip = countFreeSlotsAhead();
+				if (slotsToSkip > 0)
+					debugEV << "No neighbor in the next " << slotsToSkip << " slots, sleeping through them.\n";
+				scheduleAt(simTime()+(1 + slotsToSkip)*slotDuration, wakeup);
+			}
 		}
 		else if(msg->getKind() == LMAC_SETUP_PHASE_END)
 		{
@@ -266,25 +300,7 @@ void LMacLayer::handleSelfMsg(cMessage *msg)
 				collision = true;
 			}
 
-			for (int s = 0; s < numSlots; s++) {
-				occSlotsAway[s] = mac->getOccupiedSlots(s);
-				debugEV << "Occupied slot " << s << ": " << occSlotsAway[s] << endl;
-				debugEV << "Occupied direct slot " << s << ": " << occSlotsDirect[s] << endl;
-			}
-
-			if (mac->getMySlot() >-1)
-			{
-				// check first whether this address didn't have another occupied slot and free it again
-				for (int i=0; i < numSlots; i++)
-				{
-					if (occSlotsDirect[i] == mac->getSrcAddr())
-						occSlotsDirect[i] = LMAC_FREE_SLOT;
-					if (occSlotsAway[i] == mac->getSrcAddr())
-						occSlotsAway[i] = LMAC_FREE_SLOT;
-				}
-				occSlotsAway[mac->getMySlot()]   = mac->getSrcAddr();
-				occSlotsDirect[mac->getMySlot()] = mac->getSrcAddr();
-			}
+			updateSlotTables(mac);
 			collision = collision || (mac->getMySlot() == mySlot);
 			if (((mySlot > -1) && (mac->getOccupiedSlots(mySlot) > LMAC_FREE_SLOT) && (mac->getOccupiedSlots(mySlot) != myMacAddr)) || collision)
 			{
@@ -377,28 +393,7 @@ void LMacLayer::handleSelfMsg(cMessage *msg)
 			bool collision = false;
 
 			// check first the slot assignment
-			// copy the current slot assignment
-
-			for (int s = 0; s < numSlots; s++)
-			{
-				occSlotsAway[s] = mac->getOccupiedSlots(s);
-				debugEV << "Occupied slot " << s << ": " << occSlotsAway[s] << endl;
-				debugEV << "Occupied direct slot " << s << ": " << occSlotsDirect[s] << endl;
-			}
-
-			if (mac->getMySlot() >-1)
-			{
-				// check first whether this address didn't have another occupied slot and free it again
-				for (int i=0; i < numSlots; i++)
-				{
-					if (occSlotsDirect[i] == mac->getSrcAddr())
-						occSlotsDirect[i] = LMAC_FREE_SLOT;
-					if (occSlotsAway[i] == mac->getSrcAddr())
-						occSlotsAway[i] = LMAC_FREE_SLOT;
-				}
-				occSlotsAway[mac->getMySlot()]   = mac->getSrcAddr();
-				occSlotsDirect[mac->getMySlot()] = mac->getSrcAddr();
-			}
+			updateSlotTables(mac);
 
 			collision = collision || (mac->getMySlot() == mySlot);
 			if (((mySlot > -1) && (mac->getOccupiedSlots(mySlot) > LMAC_FREE_SLOT) && (mac->getOccupiedSlots(mySlot) != myMacAddr)) || collision)
@@ -633,29 +628,113 @@ void LMacLayer::findNewSlot()
 {
 	// pick a random slot at the beginning and schedule the next wakeup
 	// free the old one first
-	int counter = 0;
+	const int      nbSlots   = numSlots - reservedMobileSlots;
+	const SlotMask rangeMask = (nbSlots >= MAX_SLOTS) ? ~SlotMask(0) : ((SlotMask(1) << nbSlots) - 1);
+	const SlotMask freeMask  = ~occMaskAway & rangeMask;
 
-	mySlot = intrand((numSlots - reservedMobileSlots));
-	while ((occSlotsAway[mySlot] != LMAC_FREE_SLOT) && (counter < (numSlots - reservedMobileSlots)))
-	{
-		counter++;
-		mySlot--;
-		if (mySlot < 0)
-			mySlot = (numSlots - reservedMobileSlots)-1;
-	}
-	if (occSlotsAway[mySlot] != LMAC_FREE_SLOT)
+	mySlot = intrand(nbSlots);
+	if (freeMask == 0)
 	{
 		EV << "ERROR: I cannot find a free slot. Cannot send data.\n";
 		mySlot = -1;
 	}
 	else
 	{
+		// search downwards from the random slot and wrap around at zero
+		const SlotMask belowMask = (mySlot + 1 >= MAX_SLOTS) ? ~SlotMask(0) : ((SlotMask(1) << (mySlot + 1)) - 1);
+		if ((freeMask & belowMask) != 0)
+			mySlot = highestSetBit(freeMask & belowMask);
+		else
+			mySlot = highestSetBit(freeMask);
 		EV << "ERROR: My new slot is : " << mySlot << endl;
 	}
+	limitSlotSkipping();
 	EV << "ERROR: I needed to find new slot\n";
 	slotChange->recordWithTimestamp(simTime(), FindModule<>::findHost(this)->getId()-4);
 }
 
+/**
+ * Copy the two-hop slot assignment of the sender and remember the slot the
+ * sender itself uses. The occupancy masks are kept in sync with the tables.
+ */
+void LMacLayer::updateSlotTables(const LMacPkt* mac)
+{
+	const LAddress::L2Type& src = mac->getSrcAddr();
+
+	occMaskAway = 0;
+	for (int s = 0; s < numSlots; s++)
+	{
+		occSlotsAway[s] = mac->getOccupiedSlots(s);
+		if (occSlotsAway[s] != LMAC_FREE_SLOT)
+			occMaskAway |= SlotMask(1) << s;
+		debugEV << "Occupied slot " << s << ": " << occSlotsAway[s] << endl;
+		debugEV << "Occupied direct slot " << s << ": " << occSlotsDirect[s] << endl;
+	}
+
+	if (mac->getMySlot() > -1)
+	{
+		// check first whether this address didn't have another occupied slot and free it again
+		for (SlotMask m = occMaskDirect; m != 0; m &= m - 1)
+		{
+			const int i = highestSetBit(m & -m);
+			if (occSlotsDirect[i] == src)
+			{
+				occSlotsDirect[i] = LMAC_FREE_SLOT;
+				occMaskDirect    &= ~(SlotMask(1) << i);
+			}
+		}
+		for (SlotMask m = occMaskAway; m != 0; m &= m - 1)
+		{
+			const int i = highestSetBit(m & -m);
+			if (occSlotsAway[i] == src)
+			{
+				occSlotsAway[i] = LMAC_FREE_SLOT;
+				occMaskAway    &= ~(SlotMask(1) << i);
+			}
+		}
+		occSlotsAway[mac->getMySlot()]   = src;
+		occSlotsDirect[mac->getMySlot()] = src;
+		occMaskAway   |= SlotMask(1) << mac->getMySlot();
+		occMaskDirect |= SlotMask(1) << mac->getMySlot();
+	}
+	limitSlotSkipping();
+}
+
+int LMacLayer::countFreeSlotsAhead() const
+{
+	if (isFullListenFrame(frameCount))
+		return 0;
+
+	// a slot may have been taken after we heard its owner's neighbors, the
+	// two-hop table of the last control packet already announces it
+	const SlotMask wakeMask = occMaskDirect | occMaskAway;
+	int            skip     = 0;
+	for (int slot = (currSlot + 1) % numSlots; skip < numSlots - 1; slot = (slot + 1) % numSlots)
+	{
+		if (slot == mySlot || (wakeMask & (SlotMask(1) << slot)) != 0)
+			break;
+		if (slot == 0 && isFullListenFrame(frameCount + 1))
+			break;
+		++skip;
+	}
+	return skip;
+}
+
+void LMacLayer::limitSlotSkipping()
+{
+	if (slotsToSkip == 0 || !wakeup->isScheduled())
+		return;
+
+	const int skip = std::min(slotsToSkip, countFreeSlotsAhead());
+	if (skip < slotsToSkip)
+	{
+		debugEV << "Slots ahead got a neighbor, waking up after " << skip << " skipped slots.\n";
+		slotsToSkip = skip;
+		cancelEvent(wakeup);
+		scheduleAt(currSlotStart+(1 + slotsToSkip)*slotDuration, wakeup);
+	}
+}
+
 /**
  * Encapsulates the received network-layer packet into a MacPkt and set all needed
  * header fields.
@@ -12,13 +12,13 @@
 #ifndef LMAC_LAYER_H
 #define LMAC_LAYER_H
 
-#include <list>
 
 #include "MiXiMDefs.h"
 #include "DroppedPacket.h"
 #include "BaseMacLayer.h"
 #include "PhyUtils.h"
 #include "SimpleAddress.h"
+#include "BoundedQueue.h"
 
 class LMacPkt;
 
@@ -82,7 +82,14 @@ class MIXIM_API LMacLayer : public BaseMacLayer
 		, mySlot(0)
 		, numSlots(0)
 		, currSlot()
+		, occMaskDirect(0)
+		, occMaskAway(0)
 		, reservedMobileSlots(0)
+		, skipFreeSlots(false)
+		, fullListenFrames(0)
+		, frameCount(0)
+		, slotsToSkip(0)
+		, currSlotStart()
 		, macQueue()
 		, queueLength(0)
 		, wakeup(NULL)
@@ -122,7 +129,7 @@ class MIXIM_API LMacLayer : public BaseMacLayer
         virtual macpkt_ptr_t encapsMsg(cPacket*);
 
     protected:
-        typedef std::list<LMacPkt*> MacQueue;
+        typedef BoundedQueue<LMacPkt*> MacQueue;
 
         /** @brief MAC states
          *
@@ -185,9 +192,37 @@ class MIXIM_API LMacLayer : public BaseMacLayer
         LAddress::L2Type occSlotsDirect[64];
         /** @brief Occupied slots of two-hop neighbors */
         LAddress::L2Type occSlotsAway[64];
+
+        /** @brief One bit per slot, used for occupancy tests on whole frames.*/
+        typedef uint64 SlotMask;
+
+        /** @brief Maximum number of slots per frame.*/
+        static const int MAX_SLOTS = 64;
+
+        /** @brief Bit i is set if occSlotsDirect[i] is not free.*/
+        SlotMask occMaskDirect;
+        /** @brief Bit i is set if occSlotsAway[i] is not free.*/
+        SlotMask occMaskAway;
         /** @brief The first couple of slots are reserved for nodes with special needs to avoid changing slots for them (mobile nodes) */
         int reservedMobileSlots;
 
+        /** @brief Sleep through foreign slots which no known node owns.
+         *
+         * After the setup phase the next wakeup is scheduled directly at the
+         * next slot which is our own or set in occMaskDirect or occMaskAway.
+         * Slots taken later by a node we never heard are found by the full
+         * listening frames (see fullListenFrames).
+         */
+        bool skipFreeSlots;
+        /** @brief Every fullListenFrames-th frame no slot is skipped (0: never).*/
+        int fullListenFrames;
+        /** @brief Number of frames started since the initialization.*/
+        long frameCount;
+        /** @brief Number of slots the next wakeup jumps over.*/
+        int slotsToSkip;
+        /** @brief Start time of the current slot.*/
+        simtime_t currSlotStart;
+
         /** @brief A queue to store packets from upper layer in case another
          packet is still waiting for transmission..*/
         MacQueue macQueue;
@@ -209,6 +244,23 @@ class MIXIM_API LMacLayer : public BaseMacLayer
         /** @brief find a new slot */
         void findNewSlot();
 
+        /** @brief Updates the slot tables from a received control packet.*/
+        void updateSlotTables(const LMacPkt* mac);
+
+        /** @brief Returns the number of foreign slots without known owner
+         * directly following the current slot, up to the next full listening
+         * frame.*/
+        int countFreeSlotsAhead() const;
+
+        /** @brief Returns true if no slot of the passed frame may be skipped.*/
+        bool isFullListenFrame(long frame) const {
+            return fullListenFrames > 0 && frame % fullListenFrames == 0;
+        }
+
+        /** @brief Moves an already scheduled wakeup forward if slots
+         * which should be skipped got a neighbor or became our own.*/
+        void limitSlotSkipping();
+
         /** @brief Inspect reasons for dropped packets */
         DroppedPacket droppedPacket;
 
@@ -25,6 +25,7 @@
 #include "BaseConnectionManager.h"
 #include "MacToPhyInterface.h"
 #include "ChannelSenseRequest_m.h"
+#include "Mac80211AggregatePkt.h"
 
 Define_Module(Mac80211);
 
@@ -56,6 +57,12 @@ Mac80211::Mac80211()
 	, neighbors()
 	, switching(false)
 	, fsc(0)
+	, aggregation(false)
+	, maxAggregateLength(0)
+	, maxAggregateDuration()
+	, aggregateSizes()
+	, nbAggregates(0)
+	, nbAggregatedFrames(0)
 {}
 
 void Mac80211::initialize(int stage)
@@ -72,6 +79,7 @@ void Mac80211::initialize(int stage)
         debugEV << " fsc: " << fsc << "\n";
 
         queueLength = hasPar("queueLength") ? par("queueLength").longValue() : 10;
+        fromUpperLayer.setCapacity(queueLength);
 
         // timers
         timeout = new cMessage("timeout", TIMEOUT);
@@ -129,6 +137,14 @@ void Mac80211::initialize(int stage)
 
         neighborhoodCacheSize = hasPar("neighborhoodCacheSize") ? par("neighborhoodCacheSize").longValue() : 0;
         neighborhoodCacheMaxAge = hasPar("neighborhoodCacheMaxAge") ? par("neighborhoodCacheMaxAge").longValue() : 10000;
+        neighbors.setCapacity(neighborhoodCacheSize);
+
+        aggregation          = hasPar("aggregation")          ? par("aggregation").boolValue()            : false;
+        maxAggregateLength   = hasPar("maxAggregateLength")   ? par("maxAggregateLength").doubleValue()   : 18496;
+        maxAggregateDuration = hasPar("maxAggregateDuration") ? par("maxAggregateDuration").doubleValue() : 0;
+        nbAggregates         = 0;
+        nbAggregatedFrames   = 0;
+        aggregateSizes.setName("aggregateSizes");
 
         debugEV << " MAC Address: " << myMacAddr
            << " rtsCtsThreshold: " << rtsCtsThreshold
@@ -176,7 +192,7 @@ void Mac80211::handleUpperMsg(cMessage *msg)
               pkt->getClassName(), pkt->getName(), pkt->getByteLength());
     }
 
-    if(fromUpperLayer.size() == queueLength) {
+    if(fromUpperLayer.full()) {
 		//TODO: CSMAMacLayer does create a new mac packet and sends it up. Maybe settle on a consistent solution here
         msg->setName("MAC ERROR");
         msg->setKind(PACKET_DROPPED);
@@ -536,18 +552,28 @@ void Mac80211::handleRTSframe(Mac80211Pkt * af)
  */
 void Mac80211::handleDATAframe(Mac80211Pkt * af)
 {
-    NeighborList::iterator it;
     if (rtsCts(af)) cancelEvent(timeout);  // cancel time-out event
-    it = findNeighbor(af->getSrcAddr());
-    if(it == neighbors.end()) error("Mac80211::handleDATAframe: neighbor not registered");
+    NeighborEntry* it = findNeighbor(af->getSrcAddr());
+    if(it == NULL) error("Mac80211::handleDATAframe: neighbor not registered");
     if(af->getRetry() && (it->fsc == af->getSequenceControl())) {
     	debugEV << "Mac80211::handleDATAframe suppressed duplicate message " << af
            << " fsc: " << it->fsc << "\n";
     }
     else {
         it->fsc = af->getSequenceControl();
-        // pass the packet to the upper layer
-        sendUp(decapsMsg(af));
+        // pass the packet(s) to the upper layer
+        Mac80211AggregatePkt* aggregate = dynamic_cast<Mac80211AggregatePkt*>(af);
+        if(aggregate) {
+            debugEV << "de-aggregating " << aggregate->getNbSubframes() << " subframes\n";
+            while(aggregate->getNbSubframes() > 0) {
+                Mac80211Pkt* subframe = aggregate->removeSubframe();
+                sendUp(decapsMsg(subframe));
+                delete subframe;
+            }
+        }
+        else {
+            sendUp(decapsMsg(af));
+        }
     }
     // wait a short interframe space
     if(endSifs->isScheduled()) error("Mac80211::handleDATAframe when SIFS scheduled");
@@ -658,6 +684,9 @@ void Mac80211::handleEndContentionTimer()
         phy->setRadioState(MiximRadio::TX);
         if (!nextIsBroadcast)
         {
+            if(aggregation) {
+                aggregateFrames();
+            }
             if(rtsCts(fromUpperLayer.front())) {
                 // send a RTS
                 sendRTSframe();
@@ -952,6 +981,63 @@ void Mac80211::sendBROADCASTframe()
     setState(BUSY);
 }
 
+/**
+ *  Replace the first queued frame by an aggregate if the frames behind it
+ *  go to the same destination. Only done for a first transmission attempt,
+ *  retransmissions resend the same frame. The aggregate is acknowledged
+ *  and retransmitted like any other DATA frame.
+ */
+void Mac80211::aggregateFrames()
+{
+    Mac80211Pkt* first = fromUpperLayer.front();
+    if(first->getRetry() || longRetryCounter > 0 || shortRetryCounter > 0 ||
+       dynamic_cast<Mac80211AggregatePkt*>(first) != NULL) {
+        return;
+    }
+
+    const LAddress::L2Type& dest = first->getDestAddr();
+    const double            br   = retrieveBitrate(dest);
+
+    // the MAC header is sent once, every subframe carries its own small header
+    double          length = MAC80211_HEADER_LENGTH;
+    MacPktList::size_type nbFrames = 0;
+    for(; nbFrames < fromUpperLayer.size(); ++nbFrames) {
+        const Mac80211Pkt* frame = fromUpperLayer[nbFrames];
+        if(frame->getDestAddr() != dest) {
+            break;
+        }
+        const double newLength = length + Mac80211AggregatePkt::SUBFRAME_HEADER_LENGTH
+                               + frame->getBitLength() - MAC80211_HEADER_LENGTH;
+        if(newLength > maxAggregateLength) {
+            break;
+        }
+        if(maxAggregateDuration > 0 && packetDuration(newLength, br) > maxAggregateDuration) {
+            break;
+        }
+        length = newLength;
+    }
+    if(nbFrames < 2) {
+        return;
+    }
+
+    Mac80211AggregatePkt* aggregate = new Mac80211AggregatePkt(first->getName(), first->getKind());
+    aggregate->setSrcAddr(first->getSrcAddr());
+    aggregate->setDestAddr(dest);
+    aggregate->setRetry(false);
+    aggregate->setSequenceControl(first->getSequenceControl());
+    for(MacPktList::size_type i = 0; i < nbFrames; ++i) {
+        aggregate->addSubframe(fromUpperLayer.front());
+        fromUpperLayer.pop_front();
+    }
+    aggregate->setBitLength(static_cast<int64>(length));
+    fromUpperLayer.push_front(aggregate);
+
+    nbAggregates++;
+    nbAggregatedFrames += nbFrames;
+    aggregateSizes.record(nbFrames);
+    debugEV << "aggregated " << nbFrames << " frames to " << dest << ", length: " << length << " bits\n";
+}
+
 /**
  *  Start a new contention period if the channel is free and if
  *  there's a packet to send.  Called at the end of a deferring
@@ -1051,7 +1137,8 @@ simtime_t Mac80211::backoff(bool rtscts) {
 
 /**
  *  Test if the maximal retry limit is reached, and delete the
- *  frame to send in this case.
+ *  frame to send in this case. Every frame of an aggregate is
+ *  reported to the upper layer on its own.
  */
 void Mac80211::testMaxAttempts()
 {
@@ -1063,9 +1150,22 @@ void Mac80211::testMaxAttempts()
         // delete the frame to transmit
         Mac80211Pkt *temp = fromUpperLayer.front();
         fromUpperLayer.pop_front();
-        temp->setName("MAC ERROR");
-        temp->setKind(PACKET_DROPPED);
-        sendControlUp(temp);
+        Mac80211AggregatePkt* aggregate = dynamic_cast<Mac80211AggregatePkt*>(temp);
+        if(aggregate) {
+            // report every packet of the aggregate as dropped
+            while(aggregate->getNbSubframes() > 0) {
+                Mac80211Pkt* subframe = aggregate->removeSubframe();
+                subframe->setName("MAC ERROR");
+                subframe->setKind(PACKET_DROPPED);
+                sendControlUp(subframe);
+            }
+            delete aggregate;
+        }
+        else {
+            temp->setName("MAC ERROR");
+            temp->setKind(PACKET_DROPPED);
+            sendControlUp(temp);
+        }
     }
 }
 
@@ -1216,11 +1316,10 @@ void Mac80211::suspendContention()  {
 
 double Mac80211::retrieveBitrate(const LAddress::L2Type& destAddress) {
     double bitrate = defaultBitrate;
-    NeighborList::iterator it;
     if(autoBitrate && !LAddress::isL2Broadcast(destAddress) &&
        (longRetryCounter == 0) && (shortRetryCounter == 0)) {
-        it = findNeighbor(destAddress);
-        if((it != neighbors.end()) && (it->age > (simTime() - neighborhoodCacheMaxAge))) {
+        const NeighborEntry* it = neighbors.findFresh(destAddress, simTime() - neighborhoodCacheMaxAge);
+        if(it != NULL) {
             bitrate = it->bitrate;
         }
     }
@@ -1229,38 +1328,20 @@ double Mac80211::retrieveBitrate(const LAddress::L2Type& destAddress) {
 
 void Mac80211::addNeighbor(Mac80211Pkt *af) {
     const LAddress::L2Type&   srcAddress = af->getSrcAddr();
-    NeighborList::iterator    it         = findNeighbor(srcAddress);
     const DeciderResult80211* result     = static_cast<const DeciderResult80211*>(PhyToMacControlInfo::getDeciderResult(af));
     double snr = result->getSnr();
 
     double bitrate = BITRATES_80211[0];
-    NeighborEntry entry;
 
     if(snr > snrThresholds[0]) bitrate = BITRATES_80211[1];
     if(snr > snrThresholds[1]) bitrate = BITRATES_80211[2];
     if(snr > snrThresholds[2]) bitrate = BITRATES_80211[3];
 
-    if(it != neighbors.end()) {
-        it->age = simTime();
-        it->bitrate = bitrate;
-    }
-    else {
-        if(neighbors.size() < neighborhoodCacheSize) {
-            entry.address = srcAddress;
-            entry.age = simTime();
-            entry.bitrate = bitrate;
-            entry.fsc = 0;
-            neighbors.push_back(entry);
-        }
-        else {
-            it = findOldestNeighbor();
-            if(it != neighbors.end()) {
-                it->age = simTime();
-                it->bitrate = bitrate;
-                it->address = srcAddress;
-                it->fsc = 0;
-            }
-        }
+    // new neighbors start with fsc 0 and replace the least recently heard
+    // one if the cache is full
+    NeighborEntry* entry = neighbors.refresh(srcAddress, simTime());
+    if(entry != NULL) {
+        entry->bitrate = bitrate;
     }
     debugEV << "updated information for neighbor: " << srcAddress
        << " snr: " << snr << " bitrate: " << bitrate << endl;
@@ -1274,14 +1355,17 @@ Mac80211::~Mac80211() {
 	if(endSifs && !endSifs->isScheduled())
 		delete endSifs;
 
-	MacPktList::iterator it;
-	for(it = fromUpperLayer.begin(); it != fromUpperLayer.end(); ++it) {
-        delete (*it);
+	for(MacPktList::size_type i = 0; i < fromUpperLayer.size(); ++i) {
+        delete fromUpperLayer[i];
     }
     fromUpperLayer.clear();
 }
 
 void Mac80211::finish() {
+    if(aggregation) {
+        recordScalar("nbAggregates", nbAggregates);
+        recordScalar("nbAggregatedFrames", nbAggregatedFrames);
+    }
     BaseMacLayer::finish();
 }
 
@@ -20,12 +20,13 @@
 #ifndef MAC_80211_H
 #define MAC_80211_H
 
-#include <list>
 
 #include "MiXiMDefs.h"
 #include "BaseMacLayer.h"
 #include "Consts80211.h"
 #include "Mac80211Pkt_m.h"
+#include "BoundedQueue.h"
+#include "NeighborCache.h"
 
 class ChannelSenseRequest;
 
@@ -62,7 +63,7 @@ public:
 	};
 protected:
 	/** @brief Type for a queue of Mac80211Pkts.*/
-    typedef std::list<Mac80211Pkt*> MacPktList;
+    typedef BoundedQueue<Mac80211Pkt*> MacPktList;
 
     /** Definition of the timer types */
     enum timerType {
@@ -81,19 +82,19 @@ protected:
       BUSY = 6    // during transmission of an ACK or a BROADCAST packet
     };
 
-    /** @brief Data about a neighbor host.*/
+    /** @brief Data about a neighbor host.
+     *
+     * The address and the time of the last update are kept by the
+     * NeighborCache.*/
     struct NeighborEntry {
-    	/** @brief The neighbors address.*/
-    	LAddress::L2Type address;
         int              fsc;
-        simtime_t        age;
         double           bitrate;
 
-        NeighborEntry() : address(), fsc(0), age(), bitrate(0) {}
+        NeighborEntry() : fsc(0), bitrate(0) {}
     };
 
-    /** @brief Type for a list of NeighborEntries.*/
-    typedef std::list<NeighborEntry> NeighborList;
+    /** @brief Type for the hashed cache of NeighborEntries.*/
+    typedef NeighborCache<LAddress::L2Type, NeighborEntry> NeighborList;
 
   public:
     Mac80211();
@@ -165,6 +166,11 @@ protected:
     /** @brief send broadcast frame */
     void sendBROADCASTframe();
 
+    /** @brief Packs the frames following the first queued frame into it,
+     * as long as they have the same destination and fit into the aggregate
+     * length and duration budget.*/
+    void aggregateFrames();
+
     /** @brief encapsulate packet */
     virtual macpkt_ptr_t encapsMsg(cPacket *netw);
 
@@ -206,27 +212,9 @@ protected:
     /** @brief add a new entry to the neighbor list */
     void addNeighbor(Mac80211Pkt *af);
 
-    /** @brief find a neighbor based on his address */
-    NeighborList::iterator findNeighbor(const LAddress::L2Type& address)  {
-        NeighborList::iterator it;
-        for(it = neighbors.begin(); it != neighbors.end(); ++it) {
-            if(it->address == address) break;
-        }
-        return it;
-    }
-
-    /** @brief find the oldest neighbor -- usually in order to overwrite this entry */
-    NeighborList::iterator findOldestNeighbor() {
-        NeighborList::iterator it = neighbors.begin();
-        NeighborList::iterator oldIt = neighbors.begin();
-        simtime_t age = it->age;
-        for(; it != neighbors.end(); ++it) {
-            if(it->age < age) {
-                age = it->age;
-                oldIt = it;
-            }
-        }
-        return oldIt;
+    /** @brief find a neighbor based on his address, NULL if unknown */
+    NeighborEntry* findNeighbor(const LAddress::L2Type& address)  {
+        return neighbors.find(address);
     }
 
 
@@ -331,7 +319,8 @@ protected:
     /** @brief Consider information in cache outdate if it is older than this */
     simtime_t neighborhoodCacheMaxAge;
 
-    /** @brief A list of this hosts neighbors.*/
+    /** @brief The neighbors of this host, the least recently heard one is
+     * replaced when neighborhoodCacheSize is reached.*/
     NeighborList neighbors;
 
     /** take care of switchover times */
@@ -339,6 +328,21 @@ protected:
 
     /** sequence control -- to detect duplicates*/
     int fsc;
+
+    /** @name A-MSDU style aggregation of queued unicast frames.*/
+    /*@{*/
+    /** @brief Aggregate frames to the same destination.*/
+    bool aggregation;
+    /** @brief Maximum length of an aggregate in bits.*/
+    double maxAggregateLength;
+    /** @brief Maximum duration of an aggregate, zero for no limit.*/
+    simtime_t maxAggregateDuration;
+    /** @brief Number of subframes of every sent aggregate.*/
+    cOutVector aggregateSizes;
+    /** @brief Number of sent aggregates and frames packed into them.*/
+    long nbAggregates;
+    long nbAggregatedFrames;
+    /*@}*/
 };
 
 #endif
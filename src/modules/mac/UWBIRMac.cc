@@ -54,6 +54,9 @@ void UWBIRMac::initialize(int stage) {
 		debug = par("debug").boolValue();
 		stats = par("stats").boolValue();
 		trace = par("trace").boolValue();
+		if (trace && hasPar("binaryTrace") && par("binaryTrace").boolValue()) {
+			sentPulsesTrace.open(TraceFile::defaultFileName("pulses"), getFullPath() + ".sentPulses");
+		}
 		prf   = par("PRF");
 		assert(prf == 4 || prf == 16);
 		packetsAlwaysValid = par("packetsAlwaysValid");
@@ -103,6 +106,7 @@ void UWBIRMac::finish() {
 		}
 		recordScalar("nbSentPackets", nbSentPackets);
 	}
+	sentPulsesTrace.close();
 	BaseMacLayer::finish();
 }
 
@@ -110,43 +114,40 @@ void UWBIRMac::prepareData(UWBIRMacPkt* packet, IEEE802154A::config /*cfg*/) {
 	// generate signal
 	//int nbSymbols = packet->getByteLength() * 8 + 92; // to move to ieee802154a.h
 	debugEV << "prepare Data for a packet with " << packet->getByteLength() << " data bytes." << endl;
+	IEEE802154A::config frameCfg = IEEE802154A::cfg_mandatory_16M;
 	if(prf == 4) {
-	  IEEE802154A::setConfig(IEEE802154A::cfg_mandatory_4M);
-	} else if (prf == 16) {
-		IEEE802154A::setConfig(IEEE802154A::cfg_mandatory_16M);
+		frameCfg = IEEE802154A::cfg_mandatory_4M;
 	}
-	IEEE802154A::setPSDULength(packet->getByteLength());
-	IEEE802154A::signalAndData res = IEEE802154A::generateIEEE802154AUWBSignal(simTime());
-	Signal* theSignal = res.first;
-	vector<bool>* data = res.second;
-	int nbSymbols = data->size();
+	UWBIRBitVector data;
+	Signal* theSignal = IEEE802154A::generateIEEE802154AUWBSignal(simTime(), frameCfg, packet->getByteLength(), data);
+	int nbSymbols = data.size();
 	if (trace) {
 		int nbItems = 0;
-		ConstMapping* power = theSignal->getTransmissionPower();
+		const ConstMapping* power = theSignal->getTransmissionPower();
 		ConstMappingIterator* iter = power->createConstIterator();
 		iter->jumpToBegin();
 		while (iter->hasNext()) {
 			nbItems++;
-			sentPulses.recordWithTimestamp(simTime()
-					+ iter->getPosition().getTime(), iter->getValue());
+			const simtime_t pulseTime = simTime() + iter->getPosition().getTime();
+			if (sentPulsesTrace.isEnabled()) {
+				sentPulsesTrace.record(pulseTime, iter->getValue());
+			} else {
+				sentPulses.recordWithTimestamp(pulseTime, iter->getValue());
+			}
 			iter->next();
 			//simtime_t t = simTime() + iter->getPosition().getTime();
 			//debugEV << "nbItemsTx=" << nbItems << ", t= " << t <<  ", value=" << iter->getValue() << "." << endl;
 		}
+		delete iter;
 	}
 
 	// save bit values
-	//packet->setBitValuesArraySize(data->size());
-	for (int pos = 0; pos < nbSymbols; pos = pos + 1) {
-		packet->pushBitvalue(data->at(pos));
-		//packet->setBitValues(pos, data->at(pos));
-	}
-	delete data;
+	packet->setBitVector(data);
 
 	packet->setNbSymbols(nbSymbols);
 
 	// attach control info
-	MacToUWBIRPhyControlInfo::setControlInfo(packet, theSignal, IEEE802154A::getConfig());
+	MacToUWBIRPhyControlInfo::setControlInfo(packet, theSignal, frameCfg);
 }
 
 bool UWBIRMac::validatePacket(UWBIRMacPkt *mac) {
@@ -154,28 +155,15 @@ bool UWBIRMac::validatePacket(UWBIRMacPkt *mac) {
 	if (!packetsAlwaysValid) {
 		PhyToMacControlInfo * phyToMac = dynamic_cast<PhyToMacControlInfo*> (mac->getControlInfo());
 		DeciderResultUWBIR * res = dynamic_cast<DeciderResultUWBIR*>(phyToMac->getDeciderResult());
-		const std::vector<bool> * decodedBits = res->getDecodedBits();
+		const UWBIRBitVector& decodedBits = res->getDecodedBits();
+		const UWBIRBitVector& sentBits    = mac->getBitVector();
 		int bitsToDecode = mac->getNbSymbols();
 		nbSymbolsReceived = nbSymbolsReceived + ceil((double)bitsToDecode / IEEE802154A::RSSymbolLength);
-		int nbBitErrors = 0;
+		// compare whole words of the sent and decoded bits
+		int nbBitErrors = UWBIRBitVector::countBitErrors(decodedBits, sentBits, bitsToDecode);
 		int pktSymbolErrors = 0;
-		bool currSymbolError = false;
-
-		for (int i = 0; i < bitsToDecode; i++) {
-			// Start of a new symbol
-			if (i % IEEE802154A::RSSymbolLength == 0) {
-				currSymbolError = false;
-			}
-			// bit error
-			if (decodedBits->at(i) != mac->popBitValue()) {
-				nbBitErrors++;
-				debugEV<< "Found an error at position " << i << "." << std::endl;
-				// symbol error
-				if(!currSymbolError) {
-					currSymbolError = true;
-					pktSymbolErrors = pktSymbolErrors + 1;
-				}
-			}
+		if (nbBitErrors > 0) {
+			pktSymbolErrors = UWBIRBitVector::countSymbolErrors(decodedBits, sentBits, bitsToDecode, IEEE802154A::RSSymbolLength);
 		}
 
 		debugEV << "Found " << nbBitErrors << " bit errors in MAC packet." << std::endl;
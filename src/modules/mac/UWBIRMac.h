@@ -36,6 +36,7 @@
 #include "BaseMacLayer.h"
 #include "IEEE802154A.h"
 #include "Packet.h"
+#include "TraceFile.h"
 
 class MacToPhyInterface;
 class UWBIRMacPkt;
@@ -80,6 +81,7 @@ public:
     	, dataLengths()
     	, erroneousSymbols()
     	, sentPulses()
+    	, sentPulsesTrace()
     	, receivedPulses()
     	, meanPacketBER()
     	, packetSuccessRate()
@@ -106,6 +108,8 @@ protected:
     cOutVector dataLengths;
     cOutVector erroneousSymbols;
     cOutVector sentPulses;
+    /** @brief Binary trace of the sent pulses, replaces sentPulses if binaryTrace is set.*/
+    TraceChannel sentPulsesTrace;
     cOutVector receivedPulses;
     cOutVector meanPacketBER;
     cOutVector packetSuccessRate;
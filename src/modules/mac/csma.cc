@@ -51,6 +51,9 @@ void csma::initialize(int stage) {
 
 		useMACAcks = par("useMACAcks").boolValue();
 		queueLength = par("queueLength");
+		// a full queue is detected before enqueuing, so csma always
+		// accepted one packet more than queueLength
+		macQueue.setCapacity(queueLength + 1);
 		sifs = par("sifs");
 		transmissionAttemptInterruptedByRx = false;
 		nbTxFrames = 0;
@@ -68,6 +71,7 @@ void csma::initialize(int stage) {
 		macMaxFrameRetries = par("macMaxFrameRetries");
 		macAckWaitDuration = par("macAckWaitDuration").doubleValue();
 		aUnitBackoffPeriod = par("aUnitBackoffPeriod").doubleValue();
+		coalesceBackoffTimers = par("coalesceBackoffTimers").boolValue();
 		ccaDetectionTime = par("ccaDetectionTime").doubleValue();
 		rxSetupTime = par("rxSetupTime").doubleValue();
 		aTurnaroundTime = par("aTurnaroundTime").doubleValue();
@@ -158,6 +162,7 @@ void csma::finish() {
 		}
 		recordScalar("nbBackoffs", nbBackoffs);
 		recordScalar("backoffDurations", backoffValues);
+		recordScalar("maxQueueOccupancy", macQueue.getMaxOccupancy());
 	}
 	BaseMacLayer::finish();
 }
@@ -169,10 +174,10 @@ csma::~csma() {
 	cancelAndDelete(rxAckTimer);
 	if (ackMessage)
 		delete ackMessage;
-	MacQueue::iterator it;
-	for (it = macQueue.begin(); it != macQueue.end(); ++it) {
-		delete (*it);
+	for (MacQueue::size_type i = 0; i < macQueue.size(); ++i) {
+		delete macQueue[i];
 	}
+	macQueue.clear();
 }
 
 /**
@@ -191,16 +196,18 @@ void csma::handleUpperMsg(cMessage *msg) {
 	macPkt->setSrcAddr(myMacAddr);
 
 	if(useMACAcks) {
-		if(SeqNrParent.find(dest) == SeqNrParent.end()) {
+		bool           newParent = false;
+		unsigned long& seqNr     = *SeqNrParent.refresh(dest, simTime(), &newParent);
+		if(newParent) {
 			//no record of current parent -> add next sequence number to map
-			SeqNrParent[dest] = 1;
+			seqNr = 1;
 			macPkt->setSequenceId(0);
 			debugEV << "Adding a new parent to the map of Sequence numbers:" << dest << endl;
 		}
 		else {
-			macPkt->setSequenceId(SeqNrParent[dest]);
-			debugEV << "Packet send with sequence number = " << SeqNrParent[dest] << endl;
-			SeqNrParent[dest]++;
+			macPkt->setSequenceId(seqNr);
+			debugEV << "Packet send with sequence number = " << seqNr << endl;
+			seqNr++;
 		}
 	}
 
@@ -215,8 +222,7 @@ void csma::handleUpperMsg(cMessage *msg) {
 void csma::updateStatusIdle(t_mac_event event, cMessage *msg) {
 	switch (event) {
 	case EV_SEND_REQUEST:
-		if (macQueue.size() <= queueLength) {
-			macQueue.push_back(static_cast<macpkt_ptr_t> (msg));
+		if (macQueue.push_back(static_cast<macpkt_ptr_t> (msg))) {
 			debugEV<<"(1) FSM State IDLE_1, EV_SEND_REQUEST and [TxBuff avail]: startTimerBackOff -> BACKOFF." << endl;
 			updateMacState(BACKOFF_2);
 			NB = 0;
@@ -273,6 +279,15 @@ void csma::updateStatusIdle(t_mac_event event, cMessage *msg) {
 void csma::updateStatusBackoff(t_mac_event event, cMessage *msg) {
 	switch (event) {
 	case EV_TIMER_BACKOFF:
+		if(coalesceBackoffTimers) {
+			// the timer already covered rxSetupTime and ccaDetectionTime,
+			// the CCA result is due now
+			debugEV<< "(2) FSM State BACKOFF, EV_TIMER_BACKOFF:"
+			<< " backoff and CCA time over." << endl;
+			updateMacState(CCA_3);
+			updateStatusCCA(EV_TIMER_CCA, msg);
+			break;
+		}
 		debugEV<< "(2) FSM State BACKOFF, EV_TIMER_BACKOFF:"
 		<< " starting CCA timer." << endl;
 		startTimer(TIMER_CCA);
@@ -568,8 +583,7 @@ void csma::updateStatusTransmitAck(t_mac_event event, cMessage *msg) {
 
 void csma::updateStatusNotIdle(cMessage *msg) {
 	debugEV<< "(20) FSM State NOT IDLE, EV_SEND_REQUEST. Is a TxBuffer available ?" << endl;
-	if (macQueue.size() <= queueLength) {
-		macQueue.push_back(static_cast<macpkt_ptr_t>(msg));
+	if (macQueue.push_back(static_cast<macpkt_ptr_t>(msg))) {
 		debugEV << "(21) FSM State NOT IDLE, EV_SEND_REQUEST"
 		<<" and [TxBuff avail]: enqueue packet and don't move." << endl;
 	} else {
@@ -660,7 +674,15 @@ void csma::fsmError(t_mac_event event, cMessage *msg) {
 
 void csma::startTimer(t_mac_timer timer) {
 	if (timer == TIMER_BACKOFF) {
-		scheduleAt(scheduleBackoff(), backoffTimer);
+		if(coalesceBackoffTimers) {
+			// Backoff and CCA in one event: the radio is switched to RX now
+			// instead of at the end of the backoff, the channel is sensed
+			// at the same time as with separate timers.
+			phy->setRadioState(MiximRadio::RX);
+			scheduleAt(scheduleBackoff() + rxSetupTime + ccaDetectionTime, backoffTimer);
+		} else {
+			scheduleAt(scheduleBackoff(), backoffTimer);
+		}
 	} else if (timer == TIMER_CCA) {
 		simtime_t ccaTime = rxSetupTime + ccaDetectionTime;
 		debugEV<< "(startTimer) ccaTimer value=" << ccaTime
@@ -782,14 +804,16 @@ void csma::handleLowerMsg(cMessage *msg) {
 				ackMessage->setDestAddr(src);
 				ackMessage->setBitLength(ackLength);
 				//Check for duplicates by checking expected seqNr of sender
-				if(SeqNrChild.find(src) == SeqNrChild.end()) {
+				bool           newChild = false;
+				unsigned long& expected = *SeqNrChild.refresh(src, simTime(), &newChild);
+				if(newChild) {
 					//no record of current child -> add expected next number to map
-					SeqNrChild[src] = SeqNr + 1;
+					expected = SeqNr + 1;
 					debugEV << "Adding a new child to the map of Sequence numbers:" << src << endl;
 					executeMac(EV_FRAME_RECEIVED, macPkt);
 				}
 				else {
-					ExpectedNr = SeqNrChild[src];
+					ExpectedNr = expected;
 					debugEV << "Expected Sequence number is " << ExpectedNr <<
 					" and number of packet is " << SeqNr << endl;
 					if(SeqNr < ExpectedNr) {
@@ -798,7 +822,7 @@ void csma::handleLowerMsg(cMessage *msg) {
 						executeMac(EV_DUPLICATE_RECEIVED, macPkt);
 					}
 					else {
-						SeqNrChild[src] = SeqNr + 1;
+						expected = SeqNr + 1;
 						executeMac(EV_FRAME_RECEIVED, macPkt);
 					}
 				}
@@ -30,11 +30,12 @@
 #include <string>
 #include <sstream>
 #include <vector>
-#include <list>
 
 #include "MiXiMDefs.h"
 #include "BaseMacLayer.h"
 #include "DroppedPacket.h"
+#include "BoundedQueue.h"
+#include "NeighborCache.h"
 
 class MacPkt;
 
@@ -120,7 +121,7 @@ class MIXIM_API csma : public BaseMacLayer
     virtual void handleLowerControl(cMessage *msg);
 
   protected:
-    typedef std::list<macpkt_ptr_t> MacQueue;
+    typedef BoundedQueue<macpkt_ptr_t> MacQueue;
 
     /** @name Different tracked statistics.*/
     /*@{*/
@@ -245,6 +246,12 @@ class MIXIM_API csma : public BaseMacLayer
     unsigned int macMaxFrameRetries;
     /** @brief base time unit for calculating backoff durations */
     simtime_t aUnitBackoffPeriod;
+    /**
+     * @brief If true the backoff timer fires directly when the CCA result is
+     * due (after backoff, rxSetupTime and ccaDetectionTime), so a backoff
+     * costs one event instead of two.
+     */
+    bool coalesceBackoffTimers;
     /** @brief Stores if the MAC expects Acks for Unicast packets.*/
     bool useMACAcks;
 
@@ -323,10 +330,10 @@ protected:
 
 	//sequence number for sending, map for the general case with more senders
 	//also in initialisation phase multiple potential parents
-	std::map<LAddress::L2Type, unsigned long> SeqNrParent; //parent -> sequence number
+	NeighborCache<LAddress::L2Type, unsigned long> SeqNrParent; //parent -> sequence number
 
 	//sequence numbers for receiving
-	std::map<LAddress::L2Type, unsigned long> SeqNrChild; //child -> sequence number
+	NeighborCache<LAddress::L2Type, unsigned long> SeqNrChild; //child -> sequence number
 
 private:
   	/** @brief Copy constructor is not allowed.
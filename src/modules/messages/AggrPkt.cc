@@ -1,21 +1,53 @@
+
 #include "AggrPkt.h"
 
+#include <cassert>
+
 Register_Class(AggrPkt);
 
+AggrPkt::~AggrPkt()
+{
+    clearStoredPackets();
+}
+
+AggrPkt& AggrPkt::operator=(const AggrPkt& other)
+{
+    if (this == &other)
+        return *this;
+    AggrPkt_Base::operator=(other);
+    clearStoredPackets();
+    storedPackets.reserve(other.getNbStoredPackets());
+    for (unsigned int i = other.firstStored; i < other.storedPackets.size(); ++i) {
+        pApplPkt pkt = other.storedPackets[i]->dup();
+        take(pkt); // the length was copied already
+        storedPackets.push_back(pkt);
+    }
+    return *this;
+}
+
+void AggrPkt::clearStoredPackets()
+{
+    for (unsigned int i = firstStored; i < storedPackets.size(); ++i) {
+        dropAndDelete(storedPackets[i]);
+    }
+    storedPackets.clear();
+    firstStored = 0;
+}
+
 void AggrPkt::setStoredPacketsArraySize(unsigned int /*size*/)
 {
 }
 
 unsigned int AggrPkt::getStoredPacketsArraySize() const
 {
-    return storedPackets.size();
+    return getNbStoredPackets();
 }
 
 // should not be used -- implemented only because omnet++ expects it
-pApplPkt& AggrPkt::getStoredPackets(unsigned int /*k*/)
+pApplPkt& AggrPkt::getStoredPackets(unsigned int k)
 {
-    pApplPkt& pkt = storedPackets.front();
-    return pkt;
+    assert(firstStored + k < storedPackets.size());
+    return storedPackets[firstStored + k];
 }
 
 // should not be used -- implemented only because omnet++ expects it
@@ -26,21 +58,27 @@ void AggrPkt::setStoredPackets(unsigned int /*k*/, const pApplPkt& /*storedPacke
 
 // use these functions instead
 
-void AggrPkt::storePacket(pApplPkt& msg)
+void AggrPkt::storePacket(pApplPkt msg)
 {
     take(msg); // update ownership
     storedPackets.push_back(msg);
+    addBitLength(msg->getBitLength());
 }
 
-pApplPkt& AggrPkt::popFrontPacket()
+pApplPkt AggrPkt::popFrontPacket()
 {
-    pApplPkt& pkt = storedPackets.front();
-    storedPackets.pop_front();
+    assert(firstStored < storedPackets.size());
+    pApplPkt pkt = storedPackets[firstStored++];
     drop(pkt); // update ownership
     return pkt;
 }
 
-bool AggrPkt::isEmpty()
+bool AggrPkt::isEmpty() const
+{
+    return firstStored == storedPackets.size();
+}
+
+unsigned int AggrPkt::getNbStoredPackets() const
 {
-    return storedPackets.size() == 0;
+    return storedPackets.size() - firstStored;
 }
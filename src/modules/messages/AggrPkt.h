@@ -2,17 +2,26 @@
 #ifndef AGGR_PKT_
 #define AGGR_PKT_
 
-#include <list>
+#include <vector>
 
 #include "MiXiMDefs.h"
 #include "AggrPkt_m.h"
 
+/**
+ * @brief Packet carrying several application packets, built by the
+ * Aggregation transport layer.
+ *
+ * The aggregate owns the stored packets, its length is the sum of their
+ * lengths and is updated whenever a packet is stored. Copying an aggregate
+ * copies the stored packets.
+ */
 class MIXIM_API AggrPkt : public AggrPkt_Base
 {
   public:
-    AggrPkt(const char *name=NULL, int kind=0) : AggrPkt_Base(name,kind), storedPackets() {}
-    AggrPkt(const AggrPkt& other) : AggrPkt_Base(other.getName()), storedPackets() {operator=(other);}
-    AggrPkt& operator=(const AggrPkt& other) {AggrPkt_Base::operator=(other); return *this;}
+    AggrPkt(const char *name=NULL, int kind=0) : AggrPkt_Base(name,kind), storedPackets(), firstStored(0) {}
+    AggrPkt(const AggrPkt& other) : AggrPkt_Base(other.getName()), storedPackets(), firstStored(0) {operator=(other);}
+    virtual ~AggrPkt();
+    AggrPkt& operator=(const AggrPkt& other);
     virtual AggrPkt *dup() const {return new AggrPkt(*this);}
 
     // array methods
@@ -22,13 +31,21 @@ class MIXIM_API AggrPkt : public AggrPkt_Base
     virtual pApplPkt& getStoredPackets(unsigned int k);
     virtual void setStoredPackets(unsigned int k, const pApplPkt& storedPackets_var);
     // instead, use those:
-    virtual void storePacket(pApplPkt& storedPackets_var);
-    virtual bool isEmpty();
-    virtual pApplPkt& popFrontPacket();
+    /** @brief Appends the passed packet, takes its ownership and adds its length.*/
+    virtual void storePacket(pApplPkt msg);
+    virtual bool isEmpty() const;
+    /** @brief Returns the number of packets not popped yet.*/
+    virtual unsigned int getNbStoredPackets() const;
+    /** @brief Removes the first packet and passes its ownership to the caller.*/
+    virtual pApplPkt popFrontPacket();
+    /** @brief Reserves room for the passed number of packets.*/
+    void reserve(unsigned int nbPackets) { storedPackets.reserve(nbPackets); }
   protected:
-    std::list<pApplPkt> storedPackets;
+    std::vector<pApplPkt> storedPackets;
+    /** @brief Index of the first packet not popped yet.*/
+    unsigned int          firstStored;
 
+    void clearStoredPackets();
 };
 
 #endif
-
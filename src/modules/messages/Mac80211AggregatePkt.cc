@@ -0,0 +1,75 @@
+#include "Mac80211AggregatePkt.h"
+
+#include <cassert>
+
+Register_Class(Mac80211AggregatePkt);
+
+const int Mac80211AggregatePkt::SUBFRAME_HEADER_LENGTH;
+
+Mac80211AggregatePkt::~Mac80211AggregatePkt()
+{
+    clearSubframes();
+}
+
+Mac80211AggregatePkt& Mac80211AggregatePkt::operator=(const Mac80211AggregatePkt& other)
+{
+    if (this == &other)
+        return *this;
+    Mac80211AggregatePkt_Base::operator=(other);
+    clearSubframes();
+    for (unsigned int i = other.firstSubframe; i < other.subframes.size(); ++i) {
+        addSubframe(other.subframes[i]->dup());
+    }
+    return *this;
+}
+
+void Mac80211AggregatePkt::clearSubframes()
+{
+    for (unsigned int i = firstSubframe; i < subframes.size(); ++i) {
+        dropAndDelete(subframes[i]);
+    }
+    subframes.clear();
+    firstSubframe = 0;
+}
+
+void Mac80211AggregatePkt::setSubframesArraySize(unsigned int /*size*/)
+{
+}
+
+unsigned int Mac80211AggregatePkt::getSubframesArraySize() const
+{
+    return getNbSubframes();
+}
+
+// should not be used -- implemented only because omnet++ expects it
+pMac80211Pkt& Mac80211AggregatePkt::getSubframes(unsigned int k)
+{
+    assert(firstSubframe + k < subframes.size());
+    return subframes[firstSubframe + k];
+}
+
+// should not be used -- implemented only because omnet++ expects it
+void Mac80211AggregatePkt::setSubframes(unsigned int /*k*/, const pMac80211Pkt& /*subframes_var*/)
+{
+}
+
+// use these functions instead
+
+void Mac80211AggregatePkt::addSubframe(Mac80211Pkt* frame)
+{
+    take(frame); // update ownership
+    subframes.push_back(frame);
+}
+
+unsigned int Mac80211AggregatePkt::getNbSubframes() const
+{
+    return subframes.size() - firstSubframe;
+}
+
+Mac80211Pkt* Mac80211AggregatePkt::removeSubframe()
+{
+    assert(firstSubframe < subframes.size());
+    Mac80211Pkt* frame = subframes[firstSubframe++];
+    drop(frame); // update ownership
+    return frame;
+}
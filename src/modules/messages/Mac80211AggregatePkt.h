@@ -0,0 +1,50 @@
+#ifndef MAC80211AGGREGATEPKT_H_
+#define MAC80211AGGREGATEPKT_H_
+
+#include <vector>
+
+#include "MiXiMDefs.h"
+#include "Mac80211AggregatePkt_m.h"
+
+/**
+ * @brief 802.11 DATA frame carrying several subframes for the same
+ * destination (A-MSDU style aggregation).
+ *
+ * The aggregate owns its subframes, copying an aggregate copies them.
+ *
+ * @ingroup macLayer
+ */
+class MIXIM_API Mac80211AggregatePkt : public Mac80211AggregatePkt_Base
+{
+  public:
+    /** @brief Length of the header in front of every subframe, in bits.*/
+    static const int SUBFRAME_HEADER_LENGTH = 112;
+
+    Mac80211AggregatePkt(const char *name=NULL, int kind=0) : Mac80211AggregatePkt_Base(name,kind), subframes(), firstSubframe(0) {}
+    Mac80211AggregatePkt(const Mac80211AggregatePkt& other) : Mac80211AggregatePkt_Base(other.getName()), subframes(), firstSubframe(0) {operator=(other);}
+    virtual ~Mac80211AggregatePkt();
+    Mac80211AggregatePkt& operator=(const Mac80211AggregatePkt& other);
+    virtual Mac80211AggregatePkt *dup() const {return new Mac80211AggregatePkt(*this);}
+
+    // array methods
+    // do not use these
+    virtual void setSubframesArraySize(unsigned int size);
+    virtual unsigned int getSubframesArraySize() const;
+    virtual pMac80211Pkt& getSubframes(unsigned int k);
+    virtual void setSubframes(unsigned int k, const pMac80211Pkt& subframes_var);
+    // instead, use those:
+    /** @brief Appends the passed frame and takes its ownership.*/
+    virtual void addSubframe(Mac80211Pkt* frame);
+    /** @brief Returns the number of subframes left.*/
+    virtual unsigned int getNbSubframes() const;
+    /** @brief Removes the first subframe and passes its ownership to the caller.*/
+    virtual Mac80211Pkt* removeSubframe();
+  protected:
+    std::vector<pMac80211Pkt> subframes;
+    /** @brief Index of the first subframe not removed yet.*/
+    unsigned int              firstSubframe;
+
+    void clearSubframes();
+};
+
+#endif
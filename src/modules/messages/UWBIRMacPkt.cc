@@ -9,13 +9,8 @@ UWBIRMacPkt& UWBIRMacPkt::operator=(const UWBIRMacPkt& other)
     if (this == &other)
         return *this;
     UWBIRMacPkt_Base::operator=(other);
-    bitValues.clear();
-    std::list<bool>::const_iterator citer = other.bitValues.begin();
-    while (citer != other.bitValues.end())
-    {
-        bitValues.push_back(*citer);
-        citer++;
-    }
+    bitValues = other.bitValues;
+    nextBit   = other.nextBit;
     return *this;
 }
 
@@ -26,13 +21,13 @@ void UWBIRMacPkt::setBitValuesArraySize(unsigned int /*size*/)
 
 unsigned int UWBIRMacPkt::getBitValuesArraySize() const
 {
-    return bitValues.size();
+    return bitValues.size() - nextBit;
 }
 
 bool UWBIRMacPkt::getBitValues(unsigned int k) const
 {
-    assert(k <= bitValues.size());
-    return bitValues.front(); // do not use -- implemented because omnet wants it
+    assert(nextBit + k < bitValues.size());
+    return bitValues[nextBit + k];
 }
 
 void UWBIRMacPkt::setBitValues(unsigned int /*k*/, bool /*bitValue*/)
@@ -46,13 +41,12 @@ void UWBIRMacPkt::pushBitvalue(bool bitValue)
 
 bool UWBIRMacPkt::popBitValue()
 {
-    bool bitValue = bitValues.front();
-    bitValues.pop_front();
-    return bitValue;
+    assert(nextBit < bitValues.size());
+    return bitValues[nextBit++];
 }
 
 bool UWBIRMacPkt::isEmpty()
 {
-    return bitValues.size() == 0;
+    return nextBit >= bitValues.size();
 }
 
@@ -2,16 +2,15 @@
 #ifndef UWBIRMACPKT_
 #define UWBIRMACPKT_
 
-#include <list>
-
 #include "MiXiMDefs.h"
 #include "UWBIRMacPkt_m.h"
+#include "UWBIRBitVector.h"
 
 class MIXIM_API UWBIRMacPkt : public UWBIRMacPkt_Base
 {
    public:
-     UWBIRMacPkt(const char *name=NULL, int kind=0) : UWBIRMacPkt_Base(name,kind), bitValues() {}
-     UWBIRMacPkt(const UWBIRMacPkt& other) : UWBIRMacPkt_Base(other.getName()), bitValues() {operator=(other);}
+     UWBIRMacPkt(const char *name=NULL, int kind=0) : UWBIRMacPkt_Base(name,kind), bitValues(), nextBit(0) {}
+     UWBIRMacPkt(const UWBIRMacPkt& other) : UWBIRMacPkt_Base(other.getName()), bitValues(), nextBit(0) {operator=(other);}
      UWBIRMacPkt& operator=(const UWBIRMacPkt& other);
      virtual UWBIRMacPkt *dup() const {return new UWBIRMacPkt(*this);}
      // ADD CODE HERE to redefine and implement pure virtual functions from UWBIRMacPkt_Base
@@ -22,7 +21,13 @@ class MIXIM_API UWBIRMacPkt : public UWBIRMacPkt_Base
      virtual void pushBitvalue(bool bitValue);
      virtual bool popBitValue();
      virtual bool isEmpty();
-     std::list<bool> bitValues;
+     /** @brief Returns the packed bit values, including the already popped ones.*/
+     const UWBIRBitVector& getBitVector() const { return bitValues; }
+     /** @brief Replaces the bit values by the passed ones.*/
+     void setBitVector(const UWBIRBitVector& bits) { bitValues = bits; nextBit = 0; }
+     UWBIRBitVector bitValues;
+     /** @brief Position of the next bit returned by popBitValue().*/
+     size_t nextBit;
 };
 
 #endif
@@ -25,9 +25,16 @@ void AdaptiveProbabilisticBroadcast::initialize(int stage)
         bvec.setName("Beta Vector");
 
 	    timeInNeighboursTable = par("timeInNeighboursTable");
+
+	    neighborTimer = new cMessage("removeEvent", NEIGHBOR_TIMER);
 	}
 }
 
+AdaptiveProbabilisticBroadcast::~AdaptiveProbabilisticBroadcast()
+{
+	cancelAndDelete(neighborTimer);
+}
+
 void AdaptiveProbabilisticBroadcast::handleLowerMsg(cMessage* msg)
 {
 	ProbabilisticBroadcastPkt* m = check_and_cast<ProbabilisticBroadcastPkt*>(msg);
@@ -43,38 +50,21 @@ void AdaptiveProbabilisticBroadcast::updateNeighMap(ProbabilisticBroadcastPkt* m
 	NeighborMap::key_type nodeAddress = m->getSrcAddr();
 	//EV << "updateNeighMap(): neighAddress: " << nodeAddress << endl;
 
-	//search for it in the "already-neighbors" map
-	NeighborMap::iterator it = neighMap.find(nodeAddress);
+	//insert it into or refresh it in the neighborhood map
+	bool isNew = false;
+	neighMap.refresh(nodeAddress, simTime(), &isNew);
 
-	//if the node is a "new" neighbor
-	if (it == neighMap.end()) {
+	if (isNew) {
 		EV << "updateNeighMap(): The message came from a new neighbor! " << endl;
-
-		// insert key value pair <node address, event> in neighborhood map.
-		cMessage *removeEvent = new cMessage("removeEvent", NEIGHBOR_TIMER);
-
-		// schedule the event to remove the entry after initT seconds
-		scheduleAt(simTime()+timeInNeighboursTable, removeEvent);
-
-		NeighborMap::value_type pairToInsert = make_pair(nodeAddress, removeEvent);
-		pair<NeighborMap::iterator, bool> ret = neighMap.insert(pairToInsert);
-
-		// set the context pointer to point to the integer that resembles to the address of
-		// the node to be removed when the corresponding event occurs
-		(ret.first)->second->setContextPointer((void*)(&(ret.first)->first));
-
 	}
-	//if the node is NOT a "new" neighbor update its timer
 	else {
 		EV << "updateNeighMap(): The message came from an already known neighbor! " << endl;
-        //cancel the event that was scheduled to remove the entry for this neighbor
-        cancelEvent(it->second);
-        // Define a new event in order to remove the entry after initT seconds
-        // Set the context pointer to point to the integer that resembles to the address of
-        // the node to be removed when the corresponding event occurs
-		it->second->setContextPointer((void*)(&it->first));
-
-		scheduleAt(simTime()+timeInNeighboursTable, it->second);
+	}
+
+	// one timer for the whole table: it fires when the least recently
+	// heard neighbor expires and is then moved on to the next one
+	if (!neighborTimer->isScheduled()) {
+		scheduleAt(neighMap.getOldestRefresh() + timeInNeighboursTable, neighborTimer);
 	}
 	updateBeta();
 }
@@ -82,12 +72,20 @@ void AdaptiveProbabilisticBroadcast::updateNeighMap(ProbabilisticBroadcastPkt* m
 void AdaptiveProbabilisticBroadcast::handleSelfMsg(cMessage* msg)
 {
 	if (msg->getKind() == NEIGHBOR_TIMER) {
-		const NeighborMap::key_type& node = *static_cast<NeighborMap::key_type*>( msg->getContextPointer() );
-		EV << "handleSelfMsg(): Remove node "<< node <<" from NeighMap!" << endl;
-		NeighborMap::iterator it = neighMap.find(node);
-		cancelAndDelete(neighMap.find(it->first)->second);
-		neighMap.erase(it);
-		updateBeta();
+		// remove all neighbors not heard within timeInNeighboursTable
+		const simtime_t expiredBefore = simTime() - timeInNeighboursTable;
+		bool            removed       = false;
+		while (!neighMap.empty() && neighMap.getOldestRefresh() <= expiredBefore) {
+			EV << "handleSelfMsg(): Remove node "<< neighMap.getOldestKey() <<" from NeighMap!" << endl;
+			neighMap.erase(neighMap.getOldestKey());
+			removed = true;
+		}
+		if (!neighMap.empty()) {
+			scheduleAt(neighMap.getOldestRefresh() + timeInNeighboursTable, neighborTimer);
+		}
+		if (removed) {
+			updateBeta();
+		}
 	}
 	else {
 		ProbabilisticBroadcast::handleSelfMsg(msg);
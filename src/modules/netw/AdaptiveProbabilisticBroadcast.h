@@ -8,11 +8,10 @@
 #ifndef ADAPTIVEPROBABILISTICBROADCAST_H_
 #define ADAPTIVEPROBABILISTICBROADCAST_H_
 
-#include <map>
-
 #include "MiXiMDefs.h"
 #include "ProbabilisticBroadcast.h"
 #include "SimpleAddress.h"
+#include "NeighborCache.h"
 
 /**
  * @brief This class extends ProbabilisticBroadcast by adding
@@ -30,13 +29,18 @@ public:
         , timeInNeighboursTable()
         , bvec()
         , neighMap()
+        , neighborTimer(NULL)
     {}
 
+    virtual ~AdaptiveProbabilisticBroadcast();
+
     /** @brief Initialization of the module and some variables*/
     virtual void initialize(int);
 
 protected:
-    typedef std::map<LAddress::L3Type, cMessage*> NeighborMap;
+    /** @brief Neighbors heard within the last timeInNeighboursTable, the
+     * cache only tracks the time a neighbor was heard last.*/
+    typedef NeighborCache<LAddress::L3Type, bool> NeighborMap;
 
     /** @brief Handle messages from lower layer */
     virtual void handleLowerMsg(cMessage* msg);
@@ -52,6 +56,8 @@ protected:
     simtime_t   timeInNeighboursTable; ///< @brief Default ttl for NeighborTable entries in seconds
     cOutVector  bvec;
     NeighborMap neighMap;
+    /** @brief Fires when the least recently heard neighbor expires.*/
+    cMessage*   neighborTimer;
 };
 
 #endif /* ADAPTIVEPROBABILISTICBROADCAST_H_ */
@@ -59,6 +59,8 @@ void Flood::initialize(int stage) {
 			hasPar("bcDelTime") ? bcDelTime = par("bcDelTime").doubleValue() : bcDelTime = 3.0;
 			EV <<"bcMaxEntries = "<<bcMaxEntries
 			<<" bcDelTime = "<<bcDelTime<<endl;
+			bcMsgs.setMaxEntries(bcMaxEntries);
+			bcMsgs.setHoldTime(bcDelTime);
 		}
 	}
 }
@@ -102,25 +104,10 @@ void Flood::handleUpperMsg(cMessage* m) {
 	msg->setTtl(defaultTtl);
 
 	if (plainFlooding) {
-		if (bcMsgs.size() >= bcMaxEntries) {
-			cBroadcastList::iterator it;
-
-			//serach the broadcast list of outdated entries and delete them
-			for (it = bcMsgs.begin(); it != bcMsgs.end(); ++it) {
-				if (it->delTime < simTime()) {
-					bcMsgs.erase(it);
-					it--;
-					break;
-				}
-			}
-			//delete oldest entry if max size is reached
-			if (bcMsgs.size() >= bcMaxEntries) {
-				EV<<"bcMsgs is full, delete oldest entry"<<endl;
-				bcMsgs.pop_front();
-			}
-		}
-		bcMsgs.push_back(Bcast(msg->getSeqNum(), msg->getSrcAddr(), simTime() +bcDelTime));
-    }
+		// outdated entries are dropped and, if the maximum size is
+		// reached, the oldest one is replaced
+		bcMsgs.insert(msg->getSrcAddr(), msg->getSeqNum(), simTime());
+	}
 				//there is no routing so all messages are broadacst for the mac layer
 
 				sendDown(msg);
@@ -202,8 +189,8 @@ void Flood::handleLowerMsg(cMessage* m) {
 }
 
 /**
- * The bcMsgs list is searched for the arrived message. If the message
- * is in the list, it was already broadcasted and the function returns
+ * The bcMsgs table is searched for the arrived message. If the message
+ * is in the table, it was already broadcasted and the function returns
  * false.
  *
  * Concurrently all outdated (older than bcDelTime) are deleted. If
@@ -214,31 +201,10 @@ bool Flood::notBroadcasted(netwpkt_ptr_t msg) {
 	if (!plainFlooding)
 		return true;
 
-	cBroadcastList::iterator it;
-
-	//serach the broadcast list of outdated entries and delete them
-	for (it = bcMsgs.begin(); it != bcMsgs.end(); it++) {
-		if (it->delTime < simTime()) {
-			bcMsgs.erase(it);
-			it--;
-		}
-		//message was already broadcasted
-		if ((it->srcAddr == msg->getSrcAddr()) && (it->seqNum
-				== msg->getSeqNum())) {
-			// update entry
-			it->delTime = simTime() + bcDelTime;
-			return false;
-		}
-	}
-
-	//delete oldest entry if max size is reached
-	if (bcMsgs.size() >= bcMaxEntries) {
-		EV<<"bcMsgs is full, delete oldest entry\n";
-		bcMsgs.pop_front();
-	}
-
-	bcMsgs.push_back(Bcast(msg->getSeqNum(), msg->getSrcAddr(), simTime() +bcDelTime));
-    return true;
+	// drops outdated entries, refreshes the entry of an already
+	// broadcasted message or enters a new one (replacing the oldest
+	// entry if the maximum size is reached)
+	return bcMsgs.insert(msg->getSrcAddr(), msg->getSeqNum(), simTime());
 }
 
 Flood::netwpkt_ptr_t Flood::encapsMsg(cPacket *appPkt) {
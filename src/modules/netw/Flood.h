@@ -23,17 +23,16 @@
 #ifndef _FLOOD_H_
 #define _FLOOD_H_
 
-#include <list>
-
 #include "MiXiMDefs.h"
 #include "BaseNetwLayer.h"
 #include "SimpleAddress.h"
+#include "DuplicateFilter.h"
 
 /**
  * @brief A simple flooding protocol
  *
  * This implementation uses plain flooding, i.e. it "remembers"
- * (stores) already broadcasted messages in a list and does not
+ * (stores) already broadcasted messages in a hashed DuplicateFilter and does not
  * rebroadcast them again, if it gets another copy of that message.
  *
  * The maximum number of entires for that list can be defined in the
@@ -60,20 +59,9 @@ protected:
     /** @brief Defines whether to use plain flooding or not*/
     bool plainFlooding;
 
-    class Bcast {
-    public:
-        unsigned long    seqNum;
-        LAddress::L3Type srcAddr;
-        simtime_t        delTime;
-    public:
-        Bcast(unsigned long n=0, const LAddress::L3Type& s = LAddress::L3NULL,  simtime_t_cref d=SIMTIME_ZERO) :
-            seqNum(n), srcAddr(s), delTime(d) {
-        }
-    };
-
-    typedef std::list<Bcast> cBroadcastList;
+    typedef DuplicateFilter<LAddress::L3Type> cBroadcastList;
 
-    /** @brief List of already broadcasted messages*/
+    /** @brief Already broadcasted messages (source address and sequence number)*/
     cBroadcastList bcMsgs;
 
     /**
@@ -11,7 +11,6 @@
 #include "MacToNetwControlInfo.h"
 #include "ProbBcastNetwControlInfo.h"
 
-using std::make_pair;
 using std::endl;
 
 Define_Module(ProbabilisticBroadcast);
@@ -33,6 +32,10 @@ void ProbabilisticBroadcast::initialize(int stage)
 	    timeInQueueAfterDeath = par("timeInQueueAfterDeath");
 	    timeToLive = par("timeToLive");
 	    broadcastTimer = new cMessage("broadcastTimer");
+	    // slots of a quarter broadcast period, so a slot rarely holds
+	    // more than a few messages and the wheel covers 64 periods
+	    if (broadcastPeriod > 0)
+	        msgQueue.setGeometry(broadcastPeriod / 4, 256);
 	    maxFirstBcastBackoff = par("maxFirstBcastBackoff");
 	    oneHopLatencies.setName("oneHopLatencies");
 	    nbDataPacketsReceived = 0;
@@ -203,9 +206,7 @@ void ProbabilisticBroadcast::finish()
 	cancelAndDelete(broadcastTimer);
 	// if some messages are still in the queue, delete them.
 	while (!msgQueue.empty()) {
-		TimeMsgMap::iterator pos = msgQueue.begin();
-		tMsgDesc* msgDesc = pos->second;
-		msgQueue.erase(pos);
+		tMsgDesc* msgDesc = msgQueue.pop_front();
 		delete msgDesc->pkt;
 		delete msgDesc;
 	}
@@ -240,7 +241,6 @@ bool ProbabilisticBroadcast::debugMessageKnown(unsigned int msgId)
 
 void ProbabilisticBroadcast::insertMessage(simtime_t_cref bcastDelay, tMsgDesc* msgDesc)
 {
-	TimeMsgMap::iterator pos;
 	simtime_t bcastTime = simTime() + bcastDelay;
 
 	EV << "PBr: " << simTime() << " n"  << myNetwAddr << "         insertMessage() bcastDelay = " << bcastDelay << " Msg ID = " << msgDesc->pkt->getId() << endl;
@@ -248,12 +248,16 @@ void ProbabilisticBroadcast::insertMessage(simtime_t_cref bcastDelay, tMsgDesc*
 	msgDesc->pkt->setAppTtl(msgDesc->pkt->getAppTtl() - bcastDelay);
 	// insert message ID in ID list.
 	knownMsgIds.insert(msgDesc->pkt->getId());
-	// insert key value pair <broadcast time, pointer to message> in message queue.
-	pos = msgQueue.insert(make_pair(bcastTime, msgDesc));
+	// messages with the same broadcast time keep their insertion order, so
+	// the message is in the front of the queue only if it is strictly earlier
+	// than all others.
+	const bool inFront = msgQueue.empty() || bcastTime < msgQueue.getFirstTime();
+	// insert pointer to message in message queue at its broadcast time.
+	msgQueue.insert(bcastTime, msgDesc);
 	// if the message has been inserted in the front of the list, it means that it
 	// will be the next message to be broadcasted, therefore we have to re-schedule
 	// the broadcast timer to the message's broadcast instant.
-	if (pos == msgQueue.begin()) {
+	if (inFront) {
 		EV << "PBr: " << simTime() << " n"  << myNetwAddr << "         message inserted in the front, reschedule it." << endl;
 		cancelEvent(broadcastTimer);
 		scheduleAt(bcastTime, broadcastTimer);
@@ -262,22 +266,17 @@ void ProbabilisticBroadcast::insertMessage(simtime_t_cref bcastDelay, tMsgDesc*
 
 ProbabilisticBroadcast::tMsgDesc* ProbabilisticBroadcast::popFirstMessageUpdateQueue(void)
 {
-	TimeMsgMap::iterator pos;
 	tMsgDesc* msgDesc;
 
-	// get first message.
+	// get first message and remove it from message queue and from ID list
 	ASSERT(!msgQueue.empty());
-	pos = msgQueue.begin();
-	msgDesc = pos->second;
-	// remove first message from message queue and from ID list
-	msgQueue.erase(pos);
+	msgDesc = msgQueue.pop_front();
 	knownMsgIds.erase(msgDesc->pkt->getId());
 	EV << "PBr: " << simTime() << " n"  << myNetwAddr << "         pop(): just popped msg " << msgDesc->pkt->getId() << endl;
 	if (!msgQueue.empty()) {
 		// schedule broadcast of new first message
 		EV << "PBr: " << simTime() << " n"  << myNetwAddr << "         pop(): schedule next message." << endl;
-		pos = msgQueue.begin();
-		scheduleAt(pos->first, broadcastTimer);
+		scheduleAt(msgQueue.getFirstTime(), broadcastTimer);
 	}
 	return msgDesc;
 }
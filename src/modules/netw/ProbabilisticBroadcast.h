@@ -9,11 +9,11 @@
 #define PROBABILISTICBROADCAST_H_
 
 #include <set>
-#include <map>
 
 #include "MiXiMDefs.h"
 #include "ProbabilisticBroadcastPkt_m.h"
 #include "BaseNetwLayer.h"
+#include "TimingWheel.h"
 
 /**
  * @brief This class offers a data dissemination service using
@@ -83,7 +83,8 @@ protected:
 	} tMsgDesc;
 
 	typedef std::set<unsigned int> MsgIdSet;
-	typedef std::multimap<simtime_t, tMsgDesc*> TimeMsgMap;
+	/** @brief Messages ordered by their next broadcast attempt.*/
+	typedef TimingWheel<tMsgDesc*> TimeMsgMap;
 
 	/** @brief Handle messages from upper layer */
     virtual void handleUpperMsg(cMessage* msg);
@@ -198,9 +199,8 @@ protected:
     cMessage* broadcastTimer;
 
     // we use two containers: a set which stores the ID's of the messages which are kept
-    // in memory and a multimap which stores a pair <Key, Value> where Key is the next
-    // broadcasting attempt time of the message and Value is a pointer to the message
-    // (see typedef's above).
+    // in memory and a timing wheel which orders the pointers to the messages by their
+    // next broadcasting attempt time (see typedef's above).
     MsgIdSet knownMsgIds;
     TimeMsgMap msgQueue;
     MsgIdSet debugMsgIdSet;
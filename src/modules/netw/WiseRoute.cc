@@ -37,8 +37,6 @@
 #include "SimTracer.h"
 #include "connectionManager/ConnectionManagerAccess.h"
 
-using std::make_pair;
-
 Define_Module(WiseRoute);
 
 void WiseRoute::initialize(int stage)
@@ -79,6 +77,8 @@ void WiseRoute::initialize(int stage)
 		nbPureUnicastForwarded = 0;
 		nbGetRouteFailures = 0;
 		nbRoutesRecorded = 0;
+		nbRouteLookups = 0;
+		nbRouteLookupsFailed = 0;
 		nbHops = 0;
 		receivedRSSI.setName("receivedRSSI");
 		routeRSSI.setName("routeRSSI");
@@ -128,7 +128,7 @@ void WiseRoute::handleSelfMsg(cMessage* msg)
 		pkt->setSrcAddr(myNetwAddr);
 		pkt->setDestAddr(LAddress::L3BROADCAST);
 		pkt->setNbHops(0);
-		floodTable.insert(make_pair(myNetwAddr, floodSeqNumber));
+		floodTable.refresh(myNetwAddr, simTime())->accept(floodSeqNumber);
 		pkt->setSeqNum(floodSeqNumber);
 		floodSeqNumber++;
 		pkt->setIsFlood(1);
@@ -272,7 +272,7 @@ void WiseRoute::handleUpperMsg(cMessage* msg)
 		pkt->setIsFlood(1);
 		nbFloodsSent++;
 		// record flood in flood table
-		floodTable.insert(make_pair(myNetwAddr, floodSeqNumber));
+		floodTable.refresh(myNetwAddr, simTime())->accept(floodSeqNumber);
 		pkt->setSeqNum(floodSeqNumber);
 		floodSeqNumber++;
 		nbGetRouteFailures++;
@@ -304,6 +304,8 @@ void WiseRoute::finish()
 		recordScalar("nbPureUnicastForwarded", nbPureUnicastForwarded);
 		recordScalar("nbGetRouteFailures", nbGetRouteFailures);
 		recordScalar("nbRoutesRecorded", nbRoutesRecorded);
+		recordScalar("nbRouteLookups", nbRouteLookups);
+		recordScalar("nbRouteLookupsFailed", nbRouteLookupsFailed);
 		recordScalar("meanNbHops", (double) nbHops / (double) nbDataPacketsReceived);
 	}
 	BaseNetwLayer::finish();
@@ -311,14 +313,11 @@ void WiseRoute::finish()
 
 void WiseRoute::updateRouteTable(const LAddress::L3Type& origin, const LAddress::L3Type& lastHop, double rssi, double ber)
 {
-	tRouteTable::iterator pos;
-
-	pos = routeTable.find(origin);
 	if(trace) {
 	  receivedRSSI.record(rssi);
 	  receivedBER.record(ber);
 	}
-	if (pos == routeTable.end()) {
+	if (routeTable.find(origin) == NULL) {
 		// A route towards origin does not exist yet. Insert the currently discovered one
 		// only if the received RSSI is above the threshold.
 		if (rssi > rssiThreshold) {
@@ -331,7 +330,7 @@ void WiseRoute::updateRouteTable(const LAddress::L3Type& origin, const LAddress:
 			  routeRSSI.record(rssi);
 			  routeBER.record(ber);
 			}
-			routeTable.insert(make_pair(origin, newEntry));
+			*routeTable.refresh(origin, simTime()) = newEntry;
 			if(useSimTracer) {
 			  tracer->logLink(myNetwAddr, lastHop);
 			}
@@ -365,18 +364,13 @@ cMessage* WiseRoute::decapsMsg(WiseRoutePkt *msg)
 	return m;
 }
 
-WiseRoute::floodTypes WiseRoute::updateFloodTable(bool isFlood, const tFloodTable::key_type& srcAddr, const tFloodTable::key_type& destAddr, unsigned long seqNum)
+WiseRoute::floodTypes WiseRoute::updateFloodTable(bool isFlood, const LAddress::L3Type& srcAddr, const LAddress::L3Type& destAddr, unsigned long seqNum)
 {
 	if (isFlood) {
-		tFloodTable::iterator pos = floodTable.lower_bound(srcAddr);
-		tFloodTable::iterator posEnd = floodTable.upper_bound(srcAddr);
-
-		while (pos != posEnd) {
-			if (seqNum == pos->second)
-				return DUPLICATE;  // this flood is known, don't forward it.
-			++pos;
-		}
-		floodTable.insert(make_pair(srcAddr, seqNum));
+		// floods which fell out of the sequence window of their origin
+		// are considered as known, too
+		if (!floodTable.refresh(srcAddr, simTime())->accept(seqNum))
+			return DUPLICATE;  // this flood is known, don't forward it.
 		if (destAddr == myNetwAddr)
 			return FORME;
 		else
@@ -386,15 +380,17 @@ WiseRoute::floodTypes WiseRoute::updateFloodTable(bool isFlood, const tFloodTabl
 		return NOTAFLOOD;
 }
 
-WiseRoute::tFloodTable::key_type WiseRoute::getRoute(const tFloodTable::key_type& destAddr, bool /*iAmOrigin*/) const
+LAddress::L3Type WiseRoute::getRoute(const LAddress::L3Type& destAddr, bool /*iAmOrigin*/)
 {
 	// Find a route to dest address. As in the embedded code, if no route exists, indicate
 	// final destination as next hop. If we'are lucky, final destination is one hop away...
 	// If I am the origin of the packet and no route exists, use flood, hence return broadcast
 	// address for next hop.
-	tRouteTable::const_iterator pos = routeTable.find(destAddr);
-	if (pos != routeTable.end())
-		return pos->second.nextHop;
-	else
-		return LAddress::L3BROADCAST;
+	nbRouteLookups++;
+	const tRouteTableEntry* entry = routeTable.find(destAddr);
+	if (entry != NULL)
+		return entry->nextHop;
+
+	nbRouteLookupsFailed++;
+	return LAddress::L3BROADCAST;
 }
@@ -26,12 +26,13 @@
 #ifndef wiseroute_h
 #define wiseroute_h
 
-#include <map>
 #include <omnetpp.h>
 
 #include "MiXiMDefs.h"
 #include "BaseNetwLayer.h"
 #include "SimpleAddress.h"
+#include "NeighborCache.h"
+#include "SequenceWindow.h"
 
 class SimTracer;
 class WiseRoutePkt;
@@ -86,6 +87,8 @@ public:
 		, nbPureUnicastForwarded(0)
 		, nbGetRouteFailures(0)
 		, nbRoutesRecorded(0)
+		, nbRouteLookups(0)
+		, nbRouteLookupsFailed(0)
 		, nbHops(0)
 		, receivedRSSI()
 		, routeRSSI()
@@ -123,8 +126,10 @@ protected:
 		double           rssi;
 	} tRouteTableEntry;
 
-	typedef std::map<LAddress::L3Type, tRouteTableEntry>        tRouteTable;
-	typedef std::multimap<tRouteTable::key_type, unsigned long> tFloodTable;
+	/** @brief Next hop towards each known origin, hashed by origin address.*/
+	typedef NeighborCache<LAddress::L3Type, tRouteTableEntry> tRouteTable;
+	/** @brief Sequence numbers of the floods seen from each origin.*/
+	typedef NeighborCache<LAddress::L3Type, SequenceWindow>   tFloodTable;
 
 	tRouteTable routeTable;
 	tFloodTable floodTable;
@@ -169,6 +174,8 @@ protected:
     long nbPureUnicastForwarded;
     long nbGetRouteFailures;
     long nbRoutesRecorded;
+    long nbRouteLookups;
+    long nbRouteLookupsFailed;
     long nbHops;
 
     cOutVector receivedRSSI;
@@ -209,7 +216,7 @@ protected:
      * The tuple provided in argument gives the next hop address to the origin.
      * The table is updated only if the RSSI value is above the threshold.
      */
-    virtual void updateRouteTable(const tRouteTable::key_type& origin, const LAddress::L3Type& lastHop, double rssi, double ber);
+    virtual void updateRouteTable(const LAddress::L3Type& origin, const LAddress::L3Type& lastHop, double rssi, double ber);
 
     /** @brief Decapsulate a message */
     cMessage* decapsMsg(WiseRoutePkt *msg);
@@ -217,10 +224,10 @@ protected:
     /** @brief update flood table. returns detected flood type (general or unicast flood to forward,
      *         duplicate flood to delete, unicast flood to me
      */
-    floodTypes updateFloodTable(bool isFlood, const tFloodTable::key_type& srcAddr, const tFloodTable::key_type& destAddr, unsigned long seqNum);
+    floodTypes updateFloodTable(bool isFlood, const LAddress::L3Type& srcAddr, const LAddress::L3Type& destAddr, unsigned long seqNum);
 
     /** @brief find a route to destination address. */
-    tFloodTable::key_type getRoute(const tFloodTable::key_type& destAddr, bool iAmOrigin = false) const;
+    LAddress::L3Type getRoute(const LAddress::L3Type& destAddr, bool iAmOrigin = false);
 };
 
 #endif
@@ -55,9 +55,21 @@ bool Decider802154Narrow::initFromMap(const ParameterMap& params) {
     if(it != params.end()) {
         recordStats = ParameterMap::mapped_type(it->second).boolValue();
     }
+    snirReceived.initFromMap(params);
+    snrlog.initFromMap(params);
+    berlog.initFromMap(params);
     return BaseDecider::initFromMap(params) && bInitSuccess;
 }
 
+void Decider802154Narrow::finish() {
+    if(recordStats) {
+      snirReceived.recordSummary();
+      snrlog.recordSummary();
+      berlog.recordSummary();
+    }
+    BaseDecider::finish();
+}
+
 bool Decider802154Narrow::syncOnSFD(airframe_ptr_t frame) const {
 	double BER;
 	double sfdErrorProbability;
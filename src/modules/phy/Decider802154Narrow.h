@@ -10,6 +10,7 @@
 
 #include "MiXiMDefs.h"
 #include "BaseDecider.h"
+#include "StreamingStatistic.h"
 
 /**
  * @brief Decider for the 802.15.4 Narrow band module
@@ -39,15 +40,17 @@ protected:
 	/** log minimum snir values of dropped packets */
 	cOutVector snirDropped;
 
-	/** log minimum snir values of received packets */
-	mutable cOutVector snirReceived;
+	/** log minimum snir values of received packets, the recording mode of this
+	 * and the following statistics is set by the decider parameters
+	 * "<name>Recording" (see StreamingStatistic) */
+	mutable StreamingStatistic snirReceived;
 
 
 	/** log snr value each time we enter getBERFromSNR */
-	mutable cOutVector snrlog;
+	mutable StreamingStatistic snrlog;
 
 	/** log ber value each time we enter getBERFromSNR */
-	mutable cOutVector berlog;
+	mutable StreamingStatistic berlog;
 
 protected:
 	/**
@@ -119,6 +122,9 @@ public:
 	 */
 	virtual bool initFromMap(const ParameterMap& params);
 
+	/** @brief Records the summaries of the statistics.*/
+	virtual void finish();
+
 	virtual ~Decider802154Narrow() {};
 };
 
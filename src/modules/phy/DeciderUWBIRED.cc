@@ -27,6 +27,7 @@ DeciderUWBIRED::DeciderUWBIRED( DeciderToPhyInterface* phy
     , alwaysFailOnDataInterference(true)
     , packet()
     , receivedPulses()
+    , receivedPulsesTrace()
     , syncThresholds()
     , uwbiface(dynamic_cast<PhyLayerUWBIR*>(phy))
     , nbCancelReceptions(0)
@@ -63,6 +64,12 @@ bool DeciderUWBIRED::initFromMap(const ParameterMap& params) {
         bInitSuccess = false;
         opp_warning("No trace defined in config.xml for DeciderUWBIREDSync!");
     }
+    receivedPulses.initFromMap(params);
+    syncThresholds.initFromMap(params);
+    it = params.find("binaryTrace");
+    if(trace && it != params.end() && ParameterMap::mapped_type(it->second).boolValue()) {
+        receivedPulsesTrace.open(TraceFile::defaultFileName("pulses"), uwbiface->getFullPath() + ".receivedPulses");
+    }
     it = params.find("syncAlwaysSucceeds");
     if(it != params.end()) {
         syncAlwaysSucceeds = ParameterMap::mapped_type(it->second).boolValue();
@@ -179,9 +186,9 @@ bool DeciderUWBIRED::attemptSync(const airframe_ptr_t frame) {
 DeciderResult* DeciderUWBIRED::createResult(const airframe_ptr_t frame) const {
 	if (currentSignal.first == frame) {
 		++nbFinishTrackingFrames;
-		vector<bool>*           receivedBits   = new vector<bool>();
+		UWBIRBitVector          receivedBits;
 		AirFrameUWBIR*          frameuwb       = check_and_cast<AirFrameUWBIR*>(frame);
-		std::pair<bool, double> pairCorrectSnr = decodePacket(frame, receivedBits, frameuwb->getCfg());
+		std::pair<bool, double> pairCorrectSnr = decodePacket(frame, &receivedBits, frameuwb->getCfg());
 		// we cannot compute bit error rate here
 		// so we send the packet to the MAC layer which will compare receivedBits
 		// with the actual bits sent (stored in the encapsulated UWBIRMacPkt object).
@@ -197,7 +204,7 @@ DeciderResult* DeciderUWBIRED::createResult(const airframe_ptr_t frame) const {
  * @brief Returns false if the packet is incorrect. If true,
  * the MAC layer must still compare bit values to validate the frame.
  */
-std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame, vector<bool> * receivedBits, const IEEE802154A::config& cfg) const {
+std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame, UWBIRBitVector* receivedBits, const IEEE802154A::config& cfg) const {
 
 	simtime_t now, offset;
 	simtime_t aSymbol, shift, burst;
@@ -226,13 +233,16 @@ std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame,
 	burst   = cfg.burst_duration;
 	now     = offset + cfg.pulse_duration / 2;
 	std::pair<double, double> energyZero, energyOne;
-	IEEE802154A::setConfig(cfg);
 
 	// debugging information (start)
 	if (trace && signalPower != NULL) {
 		ConstMappingIterator *const mIt = signalPower->createConstIterator();
 		while(mIt->inRange()){
-			receivedPulses.recordWithTimestamp(mIt->getPosition().getTime(), mIt->getValue());
+			if (receivedPulsesTrace.isEnabled()) {
+				receivedPulsesTrace.record(mIt->getPosition().getTime(), mIt->getValue());
+			} else {
+				receivedPulses.recordWithTimestamp(mIt->getPosition().getTime(), mIt->getValue());
+			}
 
 			if(!mIt->hasNext())
 				break;
@@ -260,7 +270,7 @@ std::pair<bool, double> DeciderUWBIRED::decodePacket(const airframe_ptr_t frame,
 		}
 
 		// sample in window zero
-		now = now + IEEE802154A::getHoppingPos(symbol)*cfg.burst_duration;
+		now = now + IEEE802154A::getHoppingPos(symbol, cfg)*cfg.burst_duration;
 		energyZero = integrateWindow(symbol, now, burst, airFrameVector, signalPower, frame, cfg);
 		// sample in window one
 		now = now + shift;
@@ -378,5 +388,8 @@ void DeciderUWBIRED::finish() {
         phy->recordScalar("nbCancelReceptions",     nbCancelReceptions);
         phy->recordScalar("nbFinishTrackingFrames", nbFinishTrackingFrames);
     }
+    receivedPulsesTrace.close();
+    receivedPulses.recordSummary();
+    syncThresholds.recordSummary();
 	BaseDecider::finish();
 }
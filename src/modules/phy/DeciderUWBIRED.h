@@ -17,8 +17,11 @@
 #include "Mapping.h"
 #include "BaseDecider.h"
 #include "IEEE802154A.h"
+#include "UWBIRBitVector.h"
 #include "UWBIRPacket.h"
 #include "MacToPhyInterface.h"
+#include "TraceFile.h"
+#include "StreamingStatistic.h"
 
 class PhyLayerUWBIR;
 class AirFrame;
@@ -72,8 +75,12 @@ protected:
 	bool synced;
 	bool alwaysFailOnDataInterference;
 	UWBIRPacket packet;
-	mutable cOutVector receivedPulses;
-	cOutVector syncThresholds;
+	/** @brief Received pulses and sync thresholds, their recording modes are set by
+	 * the decider parameters "<name>Recording" (see StreamingStatistic).*/
+	mutable StreamingStatistic receivedPulses;
+	/** @brief Binary trace of the received pulses, replaces receivedPulses if binaryTrace is set.*/
+	mutable TraceChannel receivedPulsesTrace;
+	StreamingStatistic syncThresholds;
 	PhyLayerUWBIR* uwbiface;
 	int nbCancelReceptions;
 	mutable int nbFinishTrackingFrames;
@@ -164,7 +171,7 @@ protected:
 	 */
 	virtual DeciderResult* createResult(const airframe_ptr_t frame) const;
 
-	std::pair<bool, double> decodePacket(const airframe_ptr_t frame, std::vector<bool>* receivedBits, const IEEE802154A::config& cfg) const;
+	std::pair<bool, double> decodePacket(const airframe_ptr_t frame, UWBIRBitVector* receivedBits, const IEEE802154A::config& cfg) const;
 
 	virtual bool attemptSync(const airframe_ptr_t frame);
 
@@ -71,6 +71,12 @@ protected:
 	 */
 	virtual simtime_t canAnswerCSR(const CSRInfo& requestInfo) const;
 
+	/**
+	 * @brief The answer time depends on the RSSI course, so it has to be
+	 * recalculated on every channel state change.
+	 */
+	virtual bool senseEdgeChanged() const { return true; }
+
 	/**
 	 * @brief Answers the ChannelSenseRequest (CSR) from the passed CSRInfo.
 	 *
@@ -42,6 +42,7 @@ SimpleBattery::SimpleBattery()
 	, nominalCapmAh(0)
 	, voltage(0)
 	, resolution()
+	, eventDriven(false)
 	, timeout(NULL)
 	, publish(NULL)
 	, publishDelta(0)
@@ -87,6 +88,7 @@ void SimpleBattery::initialize(int stage) {
 		}
 
 		resolution = par("resolution");
+		eventDriven = hasPar("eventDriven") ? par("eventDriven").boolValue() : false;
 
 		debugEV<< "capacity = " << capmAh << "mA-h (nominal = " << nominalCapmAh <<
 		") at " << voltage << "V" << std::endl;
@@ -110,7 +112,9 @@ void SimpleBattery::initialize(int stage) {
 
 		timeout = new cMessage("auto-update", AUTO_UPDATE);
 		timeout->setSchedulingPriority(500);
-		scheduleAt(simTime() + resolution, timeout);
+		// event driven: nothing is drawn yet, the first draw schedules it
+		if (!eventDriven)
+			scheduleAt(simTime() + resolution, timeout);
 
 		// publish battery depletion on hostStateCat
 		// periodically publish residual capacity on batteryCat
@@ -179,6 +183,8 @@ int SimpleBattery::registerDevice(const std::string& name, int numAccts)
 
 void SimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
 {
+	// called directly by the devices, the timeout may be rescheduled
+	Enter_Method_Silent();
 	if(deviceID < 0 || deviceID > registeredDevices) {
 		error("Unknown device ID!");
 	}
@@ -203,6 +209,10 @@ void SimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
 		// set the new current draw in the device vector
 		devices[deviceID].draw            = current;
 		devices[deviceID].currentActivity = activity;
+
+		// predict the next update with the new current draw
+		if (eventDriven)
+			scheduleNextUpdate();
 	}
 
 	else if (amount.getType() == DrawAmount::ENERGY) {
@@ -232,6 +242,9 @@ void SimpleBattery::draw(int deviceID, DrawAmount& amount, int activity)
 		// update the residual capacity (ongoing current draw), mostly
 		// to check whether to publish (or perish)
 		deductAndCheck();
+
+		if (eventDriven)
+			scheduleNextUpdate();
 	}
 	else {
 		error("Unknown power type!");
@@ -244,11 +257,19 @@ void SimpleBattery::handleMessage(cMessage *msg) {
 		switch (msg->getKind()) {
 		case AUTO_UPDATE:
 			// update the residual capacity (ongoing current draw)
-			scheduleAt(simTime() + resolution, timeout);
+			if (!eventDriven)
+				scheduleAt(simTime() + resolution, timeout);
 			deductAndCheck();
+			if (eventDriven)
+				scheduleNextUpdate();
 			break;
 
 		case PUBLISH:
+			// the capacity is not updated periodically, bring it up to date
+			if (eventDriven) {
+				deductAndCheck();
+				scheduleNextUpdate();
+			}
 			// publish the state to the BatteryStats module
 			emit(BatteryStats::catBatteryStateSignal, batteryState);
 			lastPublishCapacity = residualCapacity;
@@ -368,6 +389,45 @@ void SimpleBattery::deductAndCheck() {
 	residualVec.record(residualCapacity);
 }
 
+void SimpleBattery::scheduleNextUpdate() {
+	// the current draw is constant until the next draw(), which updates the
+	// capacity and calls us again
+	cancelEvent(timeout);
+	if (lessOrEqualNull(residualCapacity))
+		return;
+
+	double power = 0; // mW
+	for (int i = 0; i < numDevices; i++) {
+		if (devices[i].currentActivity > -1)
+			power += devices[i].draw * voltage;
+	}
+
+	if (power <= 0)
+		return;
+
+	// energy until depletion or until the next publishDelta step
+	double energy = residualCapacity;
+	if (publishDelta < 1) {
+		const double toPublish = residualCapacity - (lastPublishCapacity - publishDelta * capacity);
+		if (toPublish > 0 && toPublish < energy)
+			energy = toPublish;
+	}
+
+	// the prediction of a low current draw may exceed the simulation time
+	// range, the next draw() will predict again anyway
+	const simtime_t now = simTime();
+	const double    dt  = energy / power;
+	if (dt >= (MAXTIME - now).dbl())
+		return;
+
+	simtime_t next = now + dt;
+	if (next <= now) {
+		// less than one time unit left, take the next one
+		next.setRaw(SIMTIME_RAW(now) + 1);
+	}
+	scheduleAt(next, timeout);
+}
+
 	// the three functions below should be supported in all battery
 	// modules.  in SimpleBattery, they're trivial.  a more accurate model
 	// would require substantially more complex functionality here
@@ -105,6 +105,11 @@ protected:
 
 	/** @brief Debit battery at least once every resolution seconds.*/
 	simtime_t resolution;
+	/**
+	 * @brief If true, the battery is not debited periodically, the timeout
+	 * is scheduled at the (predicted) depletion or next publishDelta step.
+	 */
+	bool eventDriven;
 	cMessage *timeout;
 
 	/** @name publishing of capacity to BatteryStats via the BB. */
@@ -150,6 +155,15 @@ protected:
 	/** @brief Pointer to host module */
 	cModule* 	host;
 	virtual void deductAndCheck();
+
+	/**
+	 * @brief Schedules the timeout at the time the battery depletes or its
+	 * capacity changes by publishDelta with the current draw of all devices,
+	 * used if eventDriven is set. Has to be called after deductAndCheck()
+	 * and after a new current draw has been stored. Nothing is scheduled if
+	 * that time lies beyond MAXTIME.
+	 */
+	void scheduleNextUpdate();
 };
 
 #endif
@@ -2,6 +2,8 @@
 
 #include <iostream>
 #include <cassert>
+#include <limits>
+#include <algorithm>
 
 #include "ApplPkt_m.h"
 #include "AggrPkt.h"
@@ -16,20 +18,40 @@ Aggregation::Aggregation()
 	, aggregationTimer(NULL)
 	, interPacketDelay()
 	, nbMaxPacketsPerAggregation()
+	, flushWhenFull(false)
+	, trace(false), stats(false)
 	, nbAggrPktSentDown(0)
 	, nbAggrPktReceived(0)
+	, nbAggregatedPkts(0)
+	, sumFillRatio(0)
+	, sumAggregationDelay()
+	, fillRatioVec()
+	, aggregationDelayVec()
+{}
+
+Aggregation::destInfo::destInfo()
+	: lastSent()
+	, packets(std::numeric_limits<BoundedQueue<ApplPkt*>::size_type>::max())
 {}
 
 void Aggregation::initialize(int stage) {
     BaseLayer::initialize(stage);
 	if(stage == 0) {
 		interPacketDelay = par("interPacketDelay").doubleValue();
+		trace = par("trace");
+		stats = par("stats");
 		if(interPacketDelay > 0) {
 		  nbMaxPacketsPerAggregation = par("nbMaxPacketsPerAggregation");
 		  assert(nbMaxPacketsPerAggregation > 0);
+		  flushWhenFull = par("flushWhenFull");
 		  aggregationTimer = new cMessage("AggregationTimer");
 		  nbAggrPktSentDown = 0;
 		  nbAggrPktReceived = 0;
+		  nbAggregatedPkts = 0;
+		  sumFillRatio = 0;
+		  sumAggregationDelay = 0;
+		  fillRatioVec.setName("aggregateFillRatio");
+		  aggregationDelayVec.setName("aggregationDelay");
 		} else {
 		  interPacketDelay = 0;
 		}
@@ -42,10 +64,10 @@ bool Aggregation::isOkToSendNow(const LAddress::L3Type& dest) {
 	if(iter == destInfos.end()) {
 		// we can send directly if we meet this node for the first time
 		isOkToSendNow = true;
-	} else if(destInfos[dest].first + interPacketDelay < simTime()) {
+	} else if(iter->second.lastSent + interPacketDelay < simTime()) {
 		// we can send directly if the interPacketDelay time has expired since last transmission
 		isOkToSendNow = true;
-		assert(destInfos[dest].second.size() == 0); // otherwise the aggregation timer should have fired
+		assert(iter->second.packets.empty()); // otherwise the aggregation timer should have fired
 	}
 	return isOkToSendNow;
 }
@@ -58,9 +80,15 @@ void Aggregation::handleUpperMsg(cMessage* msg) {
 		const LAddress::L3Type& dest = pkt->getDestAddr();
 		if (!isOkToSendNow(dest)) {
 			// store packet
-			destInfos[dest].second.push_back(pkt);
+			destInfo& info = destInfos[dest];
+			info.packets.push_back(pkt);
+			if (flushWhenFull && info.packets.size() >= static_cast<size_t>(nbMaxPacketsPerAggregation)) {
+				// a full aggregate does not wait for interPacketDelay
+				sendAggregatedPacketNow(dest);
+				return;
+			}
 			// reschedule aggregation timer to "earliest destination"
-			simtime_t destTxTime = destInfos[dest].first + interPacketDelay;
+			simtime_t destTxTime = info.lastSent + interPacketDelay;
 			if (aggregationTimer->isScheduled()) {
 				if (aggregationTimer->getArrivalTime() > destTxTime) {
 					cancelEvent( aggregationTimer);
@@ -71,33 +99,45 @@ void Aggregation::handleUpperMsg(cMessage* msg) {
 			}
 		} else {
 			// send now
-			destInfos[dest].second.push_back(pkt);
+			destInfos[dest].packets.push_back(pkt);
 			sendAggregatedPacketNow(dest);
 		}
 	}
 }
 
 void Aggregation::sendAggregatedPacketNow(const LAddress::L3Type& dest) {
+  destInfo& info = destInfos[dest];
+  assert(!info.packets.empty());
+  // the packets are moved into the aggregate, which adds up their lengths
   AggrPkt* aggr = new AggrPkt("AggregationPacket", 1);
-  aggr->setBitLength(8);
+  aggr->reserve(std::min(static_cast<size_t>(nbMaxPacketsPerAggregation), info.packets.size()));
+  const simtime_t oldestArrival = info.packets.front()->getArrivalTime();
   int nbAggr = 0;
-  int pktSize = 0;
   cObject* ctrlInfo = NULL;
-  while(nbAggr < nbMaxPacketsPerAggregation && destInfos[dest].second.size() > 0) {
-	  pktSize = pktSize + destInfos[dest].second.front()->getByteLength();
+  while(nbAggr < nbMaxPacketsPerAggregation && !info.packets.empty()) {
+	  ApplPkt* pkt = info.packets.front();
+	  info.packets.pop_front();
 	  if(ctrlInfo != NULL) {
 		  delete ctrlInfo; // we delete all ctrlInfo except the last, which we attach to our message
 	  }
-	  ctrlInfo = destInfos[dest].second.front()->getControlInfo();
-	  aggr->storePacket(destInfos[dest].second.front());
-	  destInfos[dest].second.pop_front();
+	  ctrlInfo = pkt->removeControlInfo();
+	  aggr->storePacket(pkt);
 	  nbAggr = nbAggr + 1;
   }
-  aggr->setByteLength(pktSize); // why doesn't this compile ?
   aggr->setControlInfo(ctrlInfo);
   sendDown(aggr);
-  destInfos[dest].first = simTime();
+  info.lastSent = simTime();
   nbAggrPktSentDown++;
+  nbAggregatedPkts += nbAggr;
+
+  const double    fillRatio = static_cast<double>(nbAggr) / nbMaxPacketsPerAggregation;
+  const simtime_t delay     = simTime() - oldestArrival;
+  sumFillRatio        += fillRatio;
+  sumAggregationDelay += delay;
+  if(trace) {
+	  fillRatioVec.record(fillRatio);
+	  aggregationDelayVec.record(delay);
+  }
 }
 
 void Aggregation::handleLowerMsg(cMessage * msg) {
@@ -122,11 +162,11 @@ void Aggregation::handleSelfMsg(cMessage* msg) {
 	// simultaneously, compute next trigger time for aggregate timer (if required)
 	simtime_t nextTxTime = simTime() + 2*interPacketDelay;
 	while(iter != destInfos.end()) {
-		if(iter->second.first + interPacketDelay <= simTime() && iter->second.second.size() > 0) {
+		if(iter->second.lastSent + interPacketDelay <= simTime() && !iter->second.packets.empty()) {
 			sendAggregatedPacketNow(iter->first);
 		}
-		if(iter->second.second.size() > 0 && iter->second.first + interPacketDelay < nextTxTime) {
-			nextTxTime = iter->second.first + interPacketDelay;
+		if(!iter->second.packets.empty() && iter->second.lastSent + interPacketDelay < nextTxTime) {
+			nextTxTime = iter->second.lastSent + interPacketDelay;
 		}
 		iter++;
 	}
@@ -140,16 +180,21 @@ void Aggregation::finish() {
   cancelAndDelete(aggregationTimer);
   map<LAddress::L3Type, destInfo>::iterator iter = destInfos.begin();
   while(iter != destInfos.end()) {
-	  while(iter->second.second.size() > 0) {
-		  ApplPkt* pkt = iter->second.second.front();
+	  while(!iter->second.packets.empty()) {
+		  ApplPkt* pkt = iter->second.packets.front();
 		  delete pkt;
-		  iter->second.second.pop_front();
+		  iter->second.packets.pop_front();
 	  }
 	  iter++;
   }
   // save counter values
   recordScalar("nbAggrPktReceived", nbAggrPktReceived);
   recordScalar("nbAggrPktSentDown ", nbAggrPktSentDown);
+  if(stats && nbAggrPktSentDown > 0) {
+	  recordScalar("nbAggregatedPkts", nbAggregatedPkts);
+	  recordScalar("meanAggregateFillRatio", sumFillRatio / nbAggrPktSentDown);
+	  recordScalar("meanAggregationDelay", SIMTIME_DBL(sumAggregationDelay) / nbAggrPktSentDown);
+  }
 }
 
 void Aggregation::handleLowerControl(cMessage *msg) {
@@ -22,11 +22,11 @@
 
 #include <omnetpp.h>
 #include <map>
-#include <list>
 
 #include "MiXiMDefs.h"
 #include "BaseLayer.h"
 #include "SimpleAddress.h"
+#include "BoundedQueue.h"
 
 class ApplPkt;
 
@@ -58,7 +58,12 @@ class MIXIM_API Aggregation: public BaseLayer {
         // this type is used to store, for a network destination, the time
         // at which a packet was last sent to it, and the packets currently
         // queued for aggregation.
-        typedef std::pair<simtime_t, std::list<ApplPkt*> > destInfo;
+        struct destInfo {
+            simtime_t               lastSent;
+            BoundedQueue<ApplPkt*>  packets;
+
+            destInfo();
+        };
 
         // this map associates to each known netwok address
         // the time at which a packet was last sent to it, and a vector
@@ -74,6 +79,12 @@ class MIXIM_API Aggregation: public BaseLayer {
         // maximum number of packets to aggregate into a single unit.
         int nbMaxPacketsPerAggregation;
 
+        // send the packets of a destination as soon as they fill an aggregate,
+        // without waiting for interPacketDelay.
+        bool flushWhenFull;
+
+        bool trace, stats;
+
         // returns true if we can send now to this destination
         virtual bool isOkToSendNow(const LAddress::L3Type& dest);
 
@@ -83,6 +94,15 @@ class MIXIM_API Aggregation: public BaseLayer {
         // counters
         long nbAggrPktSentDown;
         long nbAggrPktReceived;
+        long nbAggregatedPkts;
+
+        // sum of the fill ratios (packets / nbMaxPacketsPerAggregation) and of the
+        // time the oldest packet waited, over all aggregates sent
+        double sumFillRatio;
+        simtime_t sumAggregationDelay;
+
+        cOutVector fillRatioVec;
+        cOutVector aggregationDelayVec;
 };
 
 #endif /* AGGREGATION_H_ */
@@ -0,0 +1,209 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        BoundedQueue.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: bounded FIFO queue on a ring buffer, used by the MAC layers
+ ***************************************************************************/
+
+#ifndef BOUNDEDQUEUE_H_
+#define BOUNDEDQUEUE_H_
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * @brief FIFO queue with a maximum number of elements, stored in a ring
+ * buffer.
+ *
+ * Enqueuing and dequeuing are O(1) and do not allocate memory once the
+ * ring buffer has grown to the number of elements used (it grows
+ * geometrically up to the capacity, so a large capacity does not cost
+ * memory up front).
+ *
+ * What happens when an element is pushed into a full queue is decided by
+ * the drop policy:
+ * - DROP_NEW: the new element is rejected, push_back() returns false.
+ * - DROP_OLDEST: the oldest element is removed and handed back to the
+ *   caller, the new element is enqueued.
+ * In both cases the caller stays responsible for the dropped element.
+ *
+ * The queue counts enqueued and dropped elements and remembers the highest
+ * occupancy, so MACs can record them as statistics.
+ *
+ * @ingroup utils
+ */
+template<class T>
+class BoundedQueue
+{
+public:
+	typedef size_t size_type;
+
+	/** @brief What to do when an element is pushed into a full queue.*/
+	enum DropPolicy {
+		DROP_NEW,
+		DROP_OLDEST
+	};
+
+protected:
+	/** @brief The ring buffer, its size is the number of usable slots.*/
+	std::vector<T> ring;
+	/** @brief Index of the oldest element in the ring.*/
+	size_type      head;
+	/** @brief Number of stored elements.*/
+	size_type      count;
+	/** @brief Maximum number of stored elements.*/
+	size_type      capacity;
+	/** @brief Handling of elements pushed into a full queue.*/
+	DropPolicy     dropPolicy;
+
+	/** @name Occupancy statistics.*/
+	/*@{*/
+	unsigned long  nbEnqueued;
+	unsigned long  nbDropped;
+	size_type      maxOccupancy;
+	/*@}*/
+
+protected:
+	size_type index(size_type i) const {
+		const size_type idx = head + i;
+		return (idx >= ring.size()) ? idx - ring.size() : idx;
+	}
+
+	/** @brief Grows the ring buffer (up to the capacity) and linearizes it.*/
+	void grow() {
+		size_type newSize = ring.empty() ? 8 : 2 * ring.size();
+		if (newSize > capacity)
+			newSize = capacity;
+
+		std::vector<T> newRing(newSize);
+		for (size_type i = 0; i < count; ++i)
+			newRing[i] = ring[index(i)];
+		ring.swap(newRing);
+		head = 0;
+	}
+
+public:
+	explicit BoundedQueue(size_type capacity = 0, DropPolicy policy = DROP_NEW):
+		ring(), head(0), count(0), capacity(capacity), dropPolicy(policy),
+		nbEnqueued(0), nbDropped(0), maxOccupancy(0)
+	{}
+
+	/** @brief Returns the maximum number of elements.*/
+	size_type getCapacity() const { return capacity; }
+
+	/**
+	 * @brief Sets the maximum number of elements.
+	 *
+	 * The queue must not hold more than the new capacity.
+	 */
+	void setCapacity(size_type newCapacity) {
+		assert(count <= newCapacity);
+		capacity = newCapacity;
+		if (ring.size() > capacity) {
+			std::vector<T> newRing(capacity);
+			for (size_type i = 0; i < count; ++i)
+				newRing[i] = ring[index(i)];
+			ring.swap(newRing);
+			head = 0;
+		}
+	}
+
+	DropPolicy getDropPolicy() const { return dropPolicy; }
+	void setDropPolicy(DropPolicy policy) { dropPolicy = policy; }
+
+	size_type size() const { return count; }
+	bool empty() const { return count == 0; }
+	bool full() const { return count >= capacity; }
+
+	/** @brief Returns the oldest element.*/
+	T& front() { assert(count > 0); return ring[head]; }
+	const T& front() const { assert(count > 0); return ring[head]; }
+
+	/** @brief Returns the newest element.*/
+	T& back() { assert(count > 0); return ring[index(count - 1)]; }
+	const T& back() const { assert(count > 0); return ring[index(count - 1)]; }
+
+	/** @brief Returns the i-th oldest element.*/
+	T& operator[](size_type i) { assert(i < count); return ring[index(i)]; }
+	const T& operator[](size_type i) const { assert(i < count); return ring[index(i)]; }
+
+	/**
+	 * @brief Appends the passed element.
+	 *
+	 * If the queue is full, the drop policy decides: with DROP_NEW false is
+	 * returned and the element is not stored. With DROP_OLDEST the oldest
+	 * element is written to "dropped" (which must not be NULL then) and the
+	 * new one is stored.
+	 */
+	bool push_back(const T& item, T* dropped = NULL) {
+		if (full()) {
+			++nbDropped;
+			if (dropPolicy == DROP_NEW || capacity == 0)
+				return false;
+
+			assert(dropped != NULL);
+			*dropped = front();
+			pop_front();
+		}
+		if (count == ring.size())
+			grow();
+
+		ring[index(count)] = item;
+		++count;
+		++nbEnqueued;
+		if (count > maxOccupancy)
+			maxOccupancy = count;
+		return true;
+	}
+
+	/**
+	 * @brief Puts the passed element in front of all others, for example
+	 * to return an element taken by pop_front().
+	 *
+	 * Returns false, without storing the element, if the queue is full.
+	 */
+	bool push_front(const T& item) {
+		if (full())
+			return false;
+		if (count == ring.size())
+			grow();
+
+		head = (head == 0) ? ring.size() - 1 : head - 1;
+		ring[head] = item;
+		++count;
+		if (count > maxOccupancy)
+			maxOccupancy = count;
+		return true;
+	}
+
+	/** @brief Removes the oldest element.*/
+	void pop_front() {
+		assert(count > 0);
+		ring[head] = T();
+		head = index(1);
+		--count;
+	}
+
+	/** @brief Removes all elements, the caller has to free them before.*/
+	void clear() {
+		while (count > 0)
+			pop_front();
+		head = 0;
+	}
+
+	/** @brief Number of elements accepted so far.*/
+	unsigned long getNbEnqueued() const { return nbEnqueued; }
+	/** @brief Number of elements dropped because the queue was full.*/
+	unsigned long getNbDropped() const { return nbDropped; }
+	/** @brief Highest number of elements stored at the same time.*/
+	size_type getMaxOccupancy() const { return maxOccupancy; }
+};
+
+#endif /* BOUNDEDQUEUE_H_ */
@@ -26,6 +26,9 @@
 
 #include <cassert>
 
+#include "UWBIRPulseMapping.h"
+#include "UWBIRBitVector.h"
+
 using std::vector;
 
 // bit rate (850 kbps)
@@ -86,8 +89,6 @@ short IEEE802154A::s_array[maxS] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
 		0, 0, 0 };
 int IEEE802154A::last_s = 15;
 
-double IEEE802154A::signalStart = 0;
-
 int IEEE802154A::psduLength = 0;
 
 //const_simtime_t IEEE802154A::MaxFrameDuration = IEEE802154A::MaxPSDULength*IEEE802154A::mandatory_symbol + IEEE802154A::mandatory_preambleLength;
@@ -147,125 +148,54 @@ simtime_t IEEE802154A::getMaxFrameDuration() {
 
 IEEE802154A::signalAndData IEEE802154A::generateIEEE802154AUWBSignal(
 		simtime_t_cref signalStart, bool allZeros) {
-	// 48 R-S parity bits, the 2 symbols phy header is not modeled as it includes its own parity bits
-	// and is thus very robust
-	unsigned int nbBits = IEEE802154A::psduLength * 8 + 48;
-	IEEE802154A::signalStart = SIMTIME_DBL(signalStart);  // use the signalStart time value as a global offset for all Mapping values
-	simtime_t signalDuration = cfg.preambleLength;
-	signalDuration += static_cast<double> (nbBits) * cfg.data_symbol_duration;
-	Signal* s = new Signal(signalStart, signalDuration);
-	vector<bool>* bitValues = new vector<bool> ();
-
 	signalAndData res;
-	int bitValue;
-	// data start time relative to signal->getReceptionStart();
-	simtime_t dataStart = cfg.preambleLength; // = Tsync + Tsfd
-	TimeMapping<Linear>* mapping = new TimeMapping<Linear> ();
-	Argument* arg = new Argument();
-	setBitRate(s);
-
-	generateSyncPreamble(mapping, arg);
-	generateSFD(mapping, arg);
-	//generatePhyHeader(mapping, arg);
-
-	// generate bit values and modulates them according to
-	// the IEEE 802.15.4A specification
-	simtime_t symbolStart = dataStart;
-	simtime_t burstPos;
-	for (unsigned int burst = 0; burst < nbBits; burst++) {
-		if(allZeros) {
-			bitValue = 0;
-		} else {
-		  bitValue = intuniform(0, 1, 0);
-		}
-		bitValues->push_back(static_cast<bool>(bitValue));
-		burstPos = symbolStart + bitValue*cfg.shift_duration + getHoppingPos(burst)*cfg.burst_duration;
-		generateBurst(mapping, arg, burstPos, +1);
-		symbolStart = symbolStart + cfg.data_symbol_duration;
-	}
-	//assert(uwbirMacPkt->getBitValuesArraySize() == dataLength);
-	//assert(bitValues->size() == nbBits);
 
-	// associate generated pulse energies to the signal
-	s->setTransmissionPower(mapping);
-	delete arg;
+	UWBIRBitVector bitValues;
 
-	res.first = s;
-	res.second = bitValues;
+	res.first  = generateIEEE802154AUWBSignal(signalStart, cfg, psduLength, bitValues, allZeros);
+	res.second = new vector<bool> ();
+	res.second->reserve(bitValues.size());
+	for (size_t i = 0; i < bitValues.size(); ++i) {
+		res.second->push_back(bitValues[i]);
+	}
 	return res;
 }
 
-void IEEE802154A::generateSyncPreamble(Mapping* mapping, Argument* arg) {
-	// NSync repetitions of the Si symbol
-	for (short n = 0; n < cfg.NSync; n = n + 1) {
-		for (short pos = 0; pos < cfg.CLength; pos = pos + 1) {
-			if (C31[Ci - 1][pos] != 0) {
-				if(n==0 && pos==0) {
-					// we slide the first pulse slightly in time to get the first point "inside" the signal
-				  arg->setTime(1E-12 + n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration);
-				} else {
-				  arg->setTime(n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration);
-				}
-				//generatePulse(mapping, arg, C31[Ci - 1][pos],
-				//		IEEE802154A::maxPulse, IEEE802154A::mandatory_pulse);
-				generatePulse(mapping, arg, 1,			// always positive polarity
-						IEEE802154A::maxPulse, cfg.pulse_duration);
-			}
-		}
-	}
-}
+Signal* IEEE802154A::generateIEEE802154AUWBSignal(simtime_t_cref signalStart, const config& frameCfg,
+		int psduBytes, UWBIRBitVector& bitValues, bool allZeros) {
+	// 48 R-S parity bits, the 2 symbols phy header is not modeled as it includes its own parity bits
+	// and is thus very robust
+	unsigned int nbBits = psduBytes * 8 + RSParityBits;
+	simtime_t signalDuration = frameCfg.preambleLength;
+	signalDuration += static_cast<double> (nbBits) * frameCfg.data_symbol_duration;
+	Signal* s = new Signal(signalStart, signalDuration);
+
+	setBitRate(s, signalStart, frameCfg);
 
-void IEEE802154A::generateSFD(Mapping* mapping, Argument* arg) {
-	double sfdStart = NSync * Tpsym;
-	for (short n = 0; n < 8; n = n + 1) {
-		if (IEEE802154A::shortSFD[n] != 0) {
-			for (short pos = 0; pos < cfg.CLength; pos = pos + 1) {
-				if (C31[Ci - 1][pos] != 0) {
-					arg->setTime(sfdStart + n*cfg.sync_symbol_duration + pos*cfg.spreadingdL*cfg.pulse_duration);
-					//generatePulse(mapping, arg, C31[Ci - 1][pos] * shortSFD[n]); // change pulse polarity
-					generatePulse(mapping, arg, 1); // always positive polarity
-				}
-			}
+	// generate bit values, they are modulated according to the
+	// IEEE 802.15.4A specification by the pulse mapping
+	bitValues.clear();
+	for (unsigned int burst = 0; burst < nbBits; burst++) {
+		if(allZeros) {
+			bitValues.push_back(false);
+		} else {
+			bitValues.push_back(intuniform(0, 1, 0) != 0);
 		}
 	}
-}
 
-void IEEE802154A::generatePhyHeader(Mapping* /*mapping*/, Argument* /*arg*/) {
-	// not implemented
+	// the pulses are computed on demand from the bit values and the hopping sequence
+	s->setTransmissionPower(new UWBIRPulseMapping(frameCfg, signalStart, bitValues));
+	return s;
 }
 
-void IEEE802154A::generatePulse(Mapping* mapping, Argument* arg,
-		short polarity, double peak, simtime_t_cref chip) {
-	assert(polarity == -1 || polarity == +1);
-	arg->setTime(arg->getTime() + IEEE802154A::signalStart);  // adjust argument so that we use absolute time values in Mapping
-	mapping->setValue(*arg, 0);
-	arg->setTime(arg->getTime() + chip / 2);
-	// Maximum point at symbol half (triangular pulse)
-	mapping->setValue(*arg, peak * polarity);
-	arg->setTime(arg->getTime() + chip / 2);
-	mapping->setValue(*arg, 0);
-}
-
-void IEEE802154A::generateBurst(Mapping* mapping, Argument* arg,
-		simtime_t_cref burstStart, short /*polarity*/) {
-	assert(burstStart < cfg.preambleLength+(psduLength*8+48+2)*cfg.data_symbol_duration);
-	// 1. Start point = zeros
-	simtime_t offset = burstStart;
-	for (int pulse = 0; pulse < cfg.nbPulsesPerBurst; pulse++) {
-		arg->setTime(offset);
-		generatePulse(mapping, arg, 1);
-		offset = offset + cfg.pulse_duration;
-	}
-}
-
-void IEEE802154A::setBitRate(Signal* s) {
+void IEEE802154A::setBitRate(Signal* s, simtime_t_cref signalStart, const config& frameCfg) {
 	Argument arg = Argument();
 	// set a constant value for bitrate
 	TimeMapping<Linear>* bitrate = new TimeMapping<Linear> ();
-	arg.setTime(IEEE802154A::signalStart); // absolute time (required for compatibility with MiXiM base RSAM code)
-	bitrate->setValue(arg, cfg.bitrate);
+	arg.setTime(signalStart); // absolute time (required for compatibility with MiXiM base RSAM code)
+	bitrate->setValue(arg, frameCfg.bitrate);
 	arg.setTime(s->getDuration());
-	bitrate->setValue(arg, cfg.bitrate);
+	bitrate->setValue(arg, frameCfg.bitrate);
 	s->setBitrate(bitrate);
 }
 
@@ -303,12 +233,16 @@ int IEEE802154A::s(int n) {
 }
 
 int IEEE802154A::getHoppingPos(int sym) {
+	return getHoppingPos(sym, cfg);
+}
+
+int IEEE802154A::getHoppingPos(int sym, const config& frameCfg) {
 	//int m = 3;  // or 5 with 4M
 	int pos = 0;
 	int kNcpb = 0;
-	switch(cfg.prf) {
+	switch(frameCfg.prf) {
 	case NOMINAL_4_M:
-		kNcpb = sym * cfg.Ncpb;
+		kNcpb = sym * frameCfg.Ncpb;
 		pos = s(kNcpb) + 2*s(1+kNcpb) + 4*s(2+kNcpb) + 8*s(3+kNcpb) + 16*s(4+kNcpb);
 		break;
 	case NOMINAL_16_M:
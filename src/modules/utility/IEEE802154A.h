@@ -31,13 +31,19 @@
 #include "MiXiMDefs.h"
 #include "Signal_.h"
 
+class UWBIRBitVector;
+
 /**
  * @brief This class regroups static methods needed to generate
  * a pulse-level representation of an IEEE 802.15.4A UWB PHY frame
  * using the mandatory mode (high PRF).
  *
  *  The main function of interest is
- * static signalAndData generateIEEE802154AUWBSignal(simtime_t signalStart, bool allZeros=false).
+ * static Signal* generateIEEE802154AUWBSignal(simtime_t_cref signalStart, const config& frameCfg,
+ *                                             int psduBytes, UWBIRBitVector& bitValues, bool allZeros=false).
+ *
+ * The pulses of the generated signal are not stored one by one, they are
+ * computed on demand by an UWBIRPulseMapping.
  *
  * @ingroup ieee802154a
  */
@@ -75,8 +81,6 @@ class MIXIM_API IEEE802154A
         static short s_array[maxS];
         static int last_s;
 
-        static double signalStart; // we cannot use a simtime_t here because the scale exponent is not yet known at initialization.
-
         /**@brief Number of Repetitions of the sync symbol in the SYNC preamble */
         static const int NSync = 64; // default sync preamble length
         /**@brief Length of the preamble code */
@@ -90,6 +94,8 @@ class MIXIM_API IEEE802154A
         static const short RSSymbolLength = 6;
         /**@brief Maximum number of erroneous symbols that the Reed-Solomon code RS_6(63,55) can correct in ieee802.15.4a */
         static const short RSMaxSymbolErrors = 4; // =(n-k)/2
+        /**@brief Number of Reed-Solomon parity bits appended to the PSDU */
+        static const int RSParityBits = 48;
 
         /**@brief Maximum size of message that is accepted by the Phy layer (in bytes). */
         static const int MaxPSDULength = 128;
@@ -170,6 +176,16 @@ class MIXIM_API IEEE802154A
          * */
         static signalAndData generateIEEE802154AUWBSignal(simtime_t_cref signalStart, bool allZeros = false);
 
+        /* @brief Generates a frame starting at time signalStart and composed of
+         * psduBytes bytes of data using the passed configuration.
+         * The generated bit values are stored in bitValues.
+         * If allZeros is set to true, all bit values are equal to zero.
+         * If it is set to false or undefined, bit values are generated randomly.
+         * Unlike the method above this one does not use the static configuration.
+         * */
+        static Signal* generateIEEE802154AUWBSignal(simtime_t_cref signalStart, const config& frameCfg, int psduBytes,
+                UWBIRBitVector& bitValues, bool allZeros = false);
+
         static simtime_t getMaxFrameDuration();
 
 // Constants from standard
@@ -177,13 +193,7 @@ class MIXIM_API IEEE802154A
         static const int Nhdr = 16;
 
     protected:
-        static void generateSyncPreamble(Mapping* mapping, Argument* arg);
-        static void generateSFD(Mapping* mapping, Argument* arg);
-        static void generatePhyHeader(Mapping* mapping, Argument* arg);
-        static void generateBurst(Mapping* mapping, Argument* arg, simtime_t_cref burstStart, short polarity);
-        static void generatePulse(Mapping* mapping, Argument* arg, short polarity, double peak = IEEE802154A::maxPulse,
-                simtime_t_cref chip = IEEE802154A::mandatory_pulse);
-        static void setBitRate(Signal* s);
+        static void setBitRate(Signal* s, simtime_t_cref signalStart, const config& frameCfg);
         static int s(int n);
 
     public:
@@ -196,6 +206,8 @@ class MIXIM_API IEEE802154A
         static simtime_t getPhyMaxFrameDuration();
         static simtime_t getThdr();
         static int getHoppingPos(int sym);
+        /* @brief Returns the time hopping position of the passed data symbol for the passed configuration. */
+        static int getHoppingPos(int sym, const config& frameCfg);
 
 };
 
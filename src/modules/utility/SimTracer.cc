@@ -24,7 +24,6 @@
 #include "FindModule.h"
 #include "BaseLayer.h"
 
-using std::map;
 using std::string;
 
 Define_Module(SimTracer);
@@ -69,37 +68,31 @@ void SimTracer::initialize(int stage)
 
 // compute current average sensor power consumption
 double SimTracer::getAvgSensorPowerConsumption() const {
-	double sensorAvgP = 0;
-	int    nbSensors  = 0;
+	if (nbSensors == 0)
+		return 0;
 
-	map < unsigned long, double >::const_iterator iter = powerConsumptions.begin(); // address, powerConsumption
-	for (; iter != powerConsumptions.end(); ++iter) {	// iterate over all nodes power consumptions
-		if(iter->first == 0)
-			continue;
-
-		double eval = iter->second;
-		eval = eval +  SIMTIME_DBL(simTime() - lastUpdates.at(iter->first)) * currPower.at(iter->first);
-		eval = eval * 1000 / SIMTIME_DBL(simTime());
-
-		++nbSensors;
-		sensorAvgP += eval;
-	}
-	if (nbSensors) {
-		sensorAvgP = sensorAvgP / nbSensors;
-	}
-	return sensorAvgP;
+	const double now = SIMTIME_DBL(simTime());
+	const double energy = sensorEnergy + now * sensorPower - sensorUpdatePower;
+	return energy * 1000 / now / nbSensors;
 }
 
 double SimTracer::getSinkPowerConsumption() const {
-	map < unsigned long, double >::const_iterator iter = powerConsumptions.find(0);
-	if (iter == powerConsumptions.end())
+	if (nodeEnergies.empty() || !nodeEnergies[0].known)
 		return 0.0;
-	double  sinkP = iter->second;
-	sinkP = sinkP + SIMTIME_DBL(simTime() - lastUpdates.at(iter->first)) * currPower.at(iter->first);
+	const NodeEnergy& sink = nodeEnergies[0];
+	double  sinkP = sink.energy;
+	sinkP = sinkP + SIMTIME_DBL(simTime() - sink.lastUpdate) * sink.power;
 	sinkP = sinkP * 1000 / SIMTIME_DBL(simTime());
 	return sinkP;
 }
 
+SimTracer::NodeEnergy& SimTracer::nodeEnergy(unsigned long mac)
+{
+	if (mac >= nodeEnergies.size())
+		nodeEnergies.resize(mac + 1);
+	return nodeEnergies[mac];
+}
+
 /*
  * Close the nam log file.
  */
@@ -140,12 +133,22 @@ void SimTracer::radioEnergyLog(unsigned long mac, int /*state*/,
   radioEnergyFile << mac << "\t" << state << "\t" << duration << "\t" << power
     << endl;
     */
-  if (powerConsumptions.count(mac) == 0) {
-    powerConsumptions[mac] = 0;
+  NodeEnergy& node = nodeEnergy(mac);
+  const double now = SIMTIME_DBL(simTime());
+  const double consumed = power * SIMTIME_DBL(duration);
+
+  if(mac != 0) {
+	  // replace the node's terms in the running sums
+	  if (!node.known)
+		  ++nbSensors;
+	  sensorEnergy      += consumed;
+	  sensorPower       += newPower - node.power;
+	  sensorUpdatePower += now * newPower - SIMTIME_DBL(node.lastUpdate) * node.power;
   }
-  powerConsumptions[mac] = powerConsumptions[mac] + power * SIMTIME_DBL(duration);
-  currPower[mac] = newPower;
-  lastUpdates[mac] = simTime();
+  node.known      = true;
+  node.energy    += consumed;
+  node.power      = newPower;
+  node.lastUpdate = simTime();
   if(mac != 0) {
 	  pSensorVec.record(getAvgSensorPowerConsumption());
   } else {
@@ -155,7 +158,8 @@ void SimTracer::radioEnergyLog(unsigned long mac, int /*state*/,
 
 void SimTracer::logPosition(int node, double x, double y, double /*z*/)
 {
-	treeFile << node << "[pos=\""<< x << ", " << y << "!\"];" << endl;
+	// no endl: the stream is flushed in blocks, not once per logged node
+	treeFile << node << "[pos=\""<< x << ", " << y << "!\"];\n";
 }
 
 void SimTracer::receiveSignal(cComponent */*source*/, simsignal_t signalID, cObject *obj)
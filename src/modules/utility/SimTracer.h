@@ -27,11 +27,11 @@
 #include <sstream>
 #include <fstream>
 #include <vector>
-#include <map>
 
 #include "MiXiMDefs.h"
 #include "BaseWorldUtility.h"
 #include "Packet.h"
+#include "FindModule.h"
 
 /**
  * @class SimTracer
@@ -57,16 +57,21 @@ public:
   	  , goodputVec()
 	  , pSinkVec()
 	  , pSensorVec()
-	  , powerConsumptions()
+	  , nodeEnergies()
 	  , packet(100)
 	  , nbApplPacketsSent(0)
 	  , nbApplPacketsReceived(0)
 	  , catEnergy(0)
-	  , powerConsumptions2()
-	  , currPower()
-	  , lastUpdates()
+	  , nbSensors(0)
+	  , sensorEnergy(0)
+	  , sensorPower(0)
+	  , sensorUpdatePower(0)
 	  , world(NULL)
-  {}
+  {
+	  GlobalModuleRegistry::add(this);
+  }
+
+  virtual ~SimTracer() { GlobalModuleRegistry::remove(this); }
 
 	/** @brief Initialization of the module and some variables*/
   virtual void initialize(int);
@@ -77,13 +82,17 @@ public:
     /** @brief Called by any module wanting to log a nam event. */
   void namLog(std::string namString);
 
+  /**
+   * @brief Called by a radio whenever its power draw changes: it consumed
+   * "power" for the last "duration" and consumes "newPower" from now on.
+   */
   void radioEnergyLog(unsigned long mac, int state, simtime_t_cref duration,
 		      double power, double newPower);
 
   /** @brief Called by a routing protocol to log a link in a tree topology. */
   template<typename T>
   void logLink(T parent, T child) {
-    treeFile << "   " << parent << " -- " << child << " ;" << endl;
+    treeFile << "   " << parent << " -- " << child << " ;\n";
   }
 
   /** @brief Called by the MAC or NET layer to log the node position. */
@@ -92,24 +101,52 @@ public:
   /** @brief Called by the signaling mechanism whenever a change occurs we're interested in */
   virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj);
 
+  /** @brief Returns the mean power consumption of all sensors (all nodes but the sink, address 0), in O(1).*/
   double getAvgSensorPowerConsumption() const;
 
   double getSinkPowerConsumption() const;
 
+protected:
+  /** @brief Energy bookkeeping of one node.*/
+  struct NodeEnergy {
+    /** @brief Energy consumed up to lastUpdate.*/
+    double    energy;
+    /** @brief Power consumed since lastUpdate.*/
+    double    power;
+    simtime_t lastUpdate;
+    /** @brief True if the node has logged its radio energy at least once.*/
+    bool      known;
+
+    NodeEnergy(): energy(0), power(0), lastUpdate(), known(false) {}
+  };
+
+  /** @brief Returns the bookkeeping of the passed node, growing the table if necessary.*/
+  NodeEnergy& nodeEnergy(unsigned long mac);
+
 protected:
    std::ofstream namFile, radioEnergyFile, treeFile;
    std::vector < std::string > packetsColors;
    cOutVector goodputVec;
    cOutVector pSinkVec;
    cOutVector pSensorVec;
-   std::map < unsigned long, double >powerConsumptions;
+   /** @brief Energy bookkeeping of all nodes, indexed by MAC address.*/
+   std::vector < NodeEnergy > nodeEnergies;
    Packet packet;
    long nbApplPacketsSent;
    long nbApplPacketsReceived;
    int catEnergy;
-   std::map < unsigned long, double >powerConsumptions2;
-   std::map < unsigned long, double >currPower;
-   std::map < unsigned long, simtime_t> lastUpdates;
+   /** @name Running sums over all sensors, so the mean is computed in O(1).
+    * The energy of sensor i at time t is energy_i + (t - lastUpdate_i) * power_i,
+    * summed up this is sensorEnergy + t * sensorPower - sensorUpdatePower.*/
+   /*@{*/
+   long   nbSensors;
+   /** @brief Sum of energy_i.*/
+   double sensorEnergy;
+   /** @brief Sum of power_i.*/
+   double sensorPower;
+   /** @brief Sum of lastUpdate_i * power_i.*/
+   double sensorUpdatePower;
+   /*@}*/
    BaseWorldUtility* world;
 };
 
@@ -0,0 +1,147 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        UWBIRBitVector.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: bit-packed storage for the payload bits of UWB-IR frames
+ ***************************************************************************/
+
+#include "UWBIRBitVector.h"
+
+#include <algorithm>
+#include <cassert>
+
+const size_t UWBIRBitVector::bitsPerWord;
+const size_t UWBIRBitVector::inlineWords;
+
+UWBIRBitVector::UWBIRBitVector():
+	nbBits(0), overflow()
+{
+	std::fill(inlineStore, inlineStore + inlineWords, word_type(0));
+}
+
+void UWBIRBitVector::clear()
+{
+	nbBits = 0;
+	std::fill(inlineStore, inlineStore + inlineWords, word_type(0));
+	overflow.clear();
+}
+
+void UWBIRBitVector::push_back(bool bit)
+{
+	const size_t wordIdx = nbBits / bitsPerWord;
+
+	if (wordIdx >= inlineWords) {
+		// frame does not fit into the inline storage anymore
+		if (overflow.empty()) {
+			overflow.assign(inlineStore, inlineStore + inlineWords);
+		}
+		if (wordIdx >= overflow.size()) {
+			overflow.push_back(0);
+		}
+	}
+	++nbBits;
+	set(nbBits - 1, bit);
+}
+
+void UWBIRBitVector::set(size_t pos, bool bit)
+{
+	assert(pos < nbBits);
+
+	const word_type mask = word_type(1) << (pos % bitsPerWord);
+	if (bit) {
+		words()[pos / bitsPerWord] |= mask;
+	} else {
+		words()[pos / bitsPerWord] &= ~mask;
+	}
+}
+
+unsigned int UWBIRBitVector::popcount(word_type w)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(w);
+#else
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return static_cast<unsigned int>((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+UWBIRBitVector::word_type UWBIRBitVector::extractBits(const word_type* w, size_t nbWords, size_t from, size_t count)
+{
+	assert(count > 0 && count <= bitsPerWord);
+
+	const size_t wordIdx = from / bitsPerWord;
+	const size_t shift   = from % bitsPerWord;
+
+	if (wordIdx >= nbWords) {
+		return 0;
+	}
+	word_type res = w[wordIdx] >> shift;
+	if (shift > 0 && wordIdx + 1 < nbWords) {
+		res |= w[wordIdx + 1] << (bitsPerWord - shift);
+	}
+	if (count < bitsPerWord) {
+		res &= (word_type(1) << count) - 1;
+	}
+	return res;
+}
+
+size_t UWBIRBitVector::countBitErrors(const UWBIRBitVector& a, const UWBIRBitVector& b, size_t count)
+{
+	assert(count <= a.size() && count <= b.size());
+
+	const word_type* wa = a.words();
+	const word_type* wb = b.words();
+	const size_t     nbFullWords = count / bitsPerWord;
+	size_t           errors      = 0;
+
+	for (size_t i = 0; i < nbFullWords; ++i) {
+		errors += popcount(wa[i] ^ wb[i]);
+	}
+	if (count % bitsPerWord != 0) {
+		const word_type mask = (word_type(1) << (count % bitsPerWord)) - 1;
+		errors += popcount((wa[nbFullWords] ^ wb[nbFullWords]) & mask);
+	}
+	return errors;
+}
+
+size_t UWBIRBitVector::countSymbolErrors(const UWBIRBitVector& a, const UWBIRBitVector& b, size_t count, size_t symbolLength)
+{
+	assert(count <= a.size() && count <= b.size());
+	assert(symbolLength > 0 && symbolLength <= bitsPerWord);
+
+	// every chunk holds a whole number of symbols
+	const size_t symbolsPerChunk = bitsPerWord / symbolLength;
+	const size_t chunkLength     = symbolsPerChunk * symbolLength;
+
+	// one bit at the first position of every symbol of a chunk
+	word_type symbolMask = 0;
+	for (size_t s = 0; s < symbolsPerChunk; ++s) {
+		symbolMask |= word_type(1) << (s * symbolLength);
+	}
+
+	const word_type* wa      = a.words();
+	const word_type* wb      = b.words();
+	const size_t     nbWords = (count + bitsPerWord - 1) / bitsPerWord;
+	size_t           errors  = 0;
+
+	for (size_t from = 0; from < count; from += chunkLength) {
+		const size_t chunkBits = std::min(chunkLength, count - from);
+		word_type    diff      = extractBits(wa, nbWords, from, chunkBits) ^ extractBits(wb, nbWords, from, chunkBits);
+
+		// fold every symbol onto its first bit
+		word_type folded = diff;
+		for (size_t i = 1; i < symbolLength; ++i) {
+			folded |= diff >> i;
+		}
+		errors += popcount(folded & symbolMask);
+	}
+	return errors;
+}
@@ -0,0 +1,115 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        UWBIRBitVector.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: bit-packed storage for the payload bits of UWB-IR frames
+ ***************************************************************************/
+
+#ifndef _UWBIRBITVECTOR_H
+#define _UWBIRBITVECTOR_H
+
+#include <vector>
+#include <cstddef>
+
+#include "MiXiMDefs.h"
+#include "IEEE802154A.h"
+
+/**
+ * @brief Stores the bit values of an UWB-IR frame packed into 64 bit words.
+ *
+ * Frames up to the maximum PSDU length of IEEE 802.15.4A (including the
+ * Reed-Solomon parity bits) are stored inside the object itself, so creating
+ * and copying bit vectors for such frames does not allocate memory. Longer
+ * frames are moved to the heap.
+ *
+ * Besides the usual container methods it provides the bit and Reed-Solomon
+ * symbol error counting between the sent and the decoded bits, which works
+ * on whole words (XOR and population count).
+ *
+ * @ingroup ieee802154a
+ */
+class MIXIM_API UWBIRBitVector {
+public:
+	typedef uint64 word_type;
+
+	/** @brief Number of bits per storage word.*/
+	static const size_t bitsPerWord = 64;
+
+	/** @brief Number of words stored inline (maximum PSDU plus the parity bits).*/
+	static const size_t inlineWords = (IEEE802154A::MaxPSDULength * 8 + IEEE802154A::RSParityBits + bitsPerWord - 1) / bitsPerWord;
+
+protected:
+	/** @brief Number of bits stored.*/
+	size_t                 nbBits;
+
+	/** @brief Inline storage, used as long as the bits fit into it.*/
+	word_type              inlineStore[inlineWords];
+
+	/** @brief Heap storage, only used for frames longer than the inline storage.*/
+	std::vector<word_type> overflow;
+
+protected:
+	word_type* words() { return overflow.empty() ? inlineStore : &overflow[0]; }
+	const word_type* words() const { return overflow.empty() ? inlineStore : &overflow[0]; }
+
+	/**
+	 * @brief Returns the passed number of bits starting at the passed bit
+	 * position, bits after the end are returned as zero.
+	 */
+	static word_type extractBits(const word_type* w, size_t nbWords, size_t from, size_t count);
+
+public:
+	UWBIRBitVector();
+
+	/** @brief Returns the number of stored bits.*/
+	size_t size() const { return nbBits; }
+
+	/** @brief Returns true if no bits are stored.*/
+	bool empty() const { return nbBits == 0; }
+
+	/** @brief Removes all bits.*/
+	void clear();
+
+	/** @brief Appends the passed bit.*/
+	void push_back(bool bit);
+
+	/** @brief Returns the bit at the passed position.*/
+	bool operator[](size_t pos) const {
+		return ((words()[pos / bitsPerWord] >> (pos % bitsPerWord)) & 1) != 0;
+	}
+
+	/** @brief Sets the bit at the passed position.*/
+	void set(size_t pos, bool bit);
+
+	/** @brief Returns the number of used storage words.*/
+	size_t getNbWords() const { return (nbBits + bitsPerWord - 1) / bitsPerWord; }
+
+	/** @brief Returns the storage word with the passed index, unused bits are zero.*/
+	word_type getWord(size_t idx) const { return words()[idx]; }
+
+	/** @brief Returns the number of set bits in the passed word.*/
+	static unsigned int popcount(word_type w);
+
+	/**
+	 * @brief Returns the number of differing bits within the first "count" bits
+	 * of the passed vectors.
+	 */
+	static size_t countBitErrors(const UWBIRBitVector& a, const UWBIRBitVector& b, size_t count);
+
+	/**
+	 * @brief Returns the number of symbols of "symbolLength" bits which contain
+	 * at least one differing bit within the first "count" bits of the passed
+	 * vectors.
+	 *
+	 * "symbolLength" has to be between 1 and 64.
+	 */
+	static size_t countSymbolErrors(const UWBIRBitVector& a, const UWBIRBitVector& b, size_t count, size_t symbolLength);
+};
+
+#endif
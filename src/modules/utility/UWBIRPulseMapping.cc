@@ -0,0 +1,276 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        UWBIRPulseMapping.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: procedural pulse-level representation of an IEEE 802.15.4A
+ *              UWB-IR frame
+ ***************************************************************************/
+
+#include "UWBIRPulseMapping.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+	/** @brief Orders key points by their position only.*/
+	struct KeyTimeLess {
+		bool operator()(const UWBIRPulseMapping::KeyEntry& a, const UWBIRPulseMapping::KeyEntry& b) const {
+			return a.first < b.first;
+		}
+		bool operator()(const UWBIRPulseMapping::KeyEntry& a, simtime_t_cref t) const {
+			return a.first < t;
+		}
+		bool operator()(simtime_t_cref t, const UWBIRPulseMapping::KeyEntry& b) const {
+			return t < b.first;
+		}
+	};
+
+	/** @brief Linear interpolation between two key points.*/
+	Argument::mapped_type interpolate(const UWBIRPulseMapping::KeyEntry& left,
+	                                  const UWBIRPulseMapping::KeyEntry& right,
+	                                  simtime_t_cref t) {
+		if(left.first == t || right.first == left.first)
+			return left.second;
+		return left.second + (right.second - left.second) * (SIMTIME_DBL(t - left.first) / SIMTIME_DBL(right.first - left.first));
+	}
+}
+
+const size_t UWBIRPulseMapping::keysPerPulse;
+
+UWBIRPulseMapping::UWBIRPulseMapping(const IEEE802154A::config& cfg, simtime_t_cref signalStart, const UWBIRBitVector& bitValues):
+	ConstMapping(), cfg(cfg), signalStart(signalStart), bitValues(bitValues),
+	hoppingPos(), codePositions(), sfdSymbols(), nbPreamblePulses(0), nbSfdPulses(0)
+{
+	for (short pos = 0; pos < cfg.CLength; pos = pos + 1) {
+		if (IEEE802154A::C31[IEEE802154A::Ci - 1][pos] != 0) {
+			codePositions.push_back(pos);
+		}
+	}
+	for (short n = 0; n < 8; n = n + 1) {
+		if (IEEE802154A::shortSFD[n] != 0) {
+			sfdSymbols.push_back(n);
+		}
+	}
+	nbPreamblePulses = cfg.NSync * codePositions.size();
+	nbSfdPulses      = sfdSymbols.size() * codePositions.size();
+
+	hoppingPos.reserve(bitValues.size());
+	for (size_t symbol = 0; symbol < bitValues.size(); ++symbol) {
+		hoppingPos.push_back(IEEE802154A::getHoppingPos(symbol, cfg));
+	}
+}
+
+simtime_t UWBIRPulseMapping::getPulseStart(size_t idx) const
+{
+	assert(idx < getNbPulses());
+
+	// sync preamble: NSync repetitions of the preamble code
+	if (idx < nbPreamblePulses) {
+		const short n   = idx / codePositions.size();
+		const short pos = codePositions[idx % codePositions.size()];
+		if (n == 0 && pos == 0) {
+			// the first pulse is slightly slided in time to get the first point "inside" the signal
+			return simtime_t(1E-12 + n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration) + signalStart;
+		}
+		return simtime_t(n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration) + signalStart;
+	}
+	idx -= nbPreamblePulses;
+
+	// start frame delimiter
+	if (idx < nbSfdPulses) {
+		const double sfdStart = SIMTIME_DBL(IEEE802154A::NSync * IEEE802154A::Tpsym);
+		const short  n        = sfdSymbols[idx / codePositions.size()];
+		const short  pos      = codePositions[idx % codePositions.size()];
+		return simtime_t(sfdStart + n * cfg.sync_symbol_duration + pos * cfg.spreadingdL * cfg.pulse_duration) + signalStart;
+	}
+	idx -= nbSfdPulses;
+
+	// data: one burst per bit, shifted by the bit value and the hopping position
+	const size_t symbol = idx / cfg.nbPulsesPerBurst;
+	const size_t pulse  = idx % cfg.nbPulsesPerBurst;
+
+	simtime_t burstPos = simtime_t(cfg.preambleLength) + static_cast<double>(symbol) * simtime_t(cfg.data_symbol_duration);
+	burstPos = burstPos + (bitValues[symbol] ? 1 : 0) * cfg.shift_duration + hoppingPos[symbol] * cfg.burst_duration;
+
+	return burstPos + static_cast<double>(pulse) * simtime_t(cfg.pulse_duration) + signalStart;
+}
+
+simtime_t UWBIRPulseMapping::getPulseDuration(size_t idx) const
+{
+	if (idx < nbPreamblePulses) {
+		return cfg.pulse_duration;
+	}
+	return IEEE802154A::mandatory_pulse;
+}
+
+size_t UWBIRPulseMapping::findPulse(simtime_t_cref t) const
+{
+	const size_t nbPulses = getNbPulses();
+
+	// pulses are ordered by their start, search the first one starting after t
+	size_t first = 0;
+	size_t count = nbPulses;
+	while (count > 0) {
+		const size_t half = count / 2;
+		if (t < getPulseStart(first + half)) {
+			count = half;
+		} else {
+			first = first + half + 1;
+			count = count - half - 1;
+		}
+	}
+	return (first == 0) ? nbPulses : first - 1;
+}
+
+void UWBIRPulseMapping::getPulseKeys(size_t idx, KeyEntry keys[keysPerPulse]) const
+{
+	const simtime_t chip = getPulseDuration(idx);
+
+	keys[0] = KeyEntry(getPulseStart(idx), 0);
+	// maximum point at symbol half (triangular pulse)
+	keys[1] = KeyEntry(keys[0].first + chip / 2, IEEE802154A::maxPulse);
+	keys[2] = KeyEntry(keys[1].first + chip / 2, 0);
+}
+
+Mapping::argument_value_t UWBIRPulseMapping::getValue(const Argument& pos) const
+{
+	const size_t    nbPulses = getNbPulses();
+	const simtime_t t        = pos.getTime();
+	const size_t    idx      = findPulse(t);
+
+	if (idx == nbPulses) {
+		return Argument::MappedZero;
+	}
+
+	// consecutive pulses of a burst may overlap, so the neighbours have to be considered too
+	KeyEntry keys[3 * keysPerPulse];
+	size_t   nbKeys = 0;
+	for (size_t i = (idx > 0) ? idx - 1 : 0; i <= idx + 1 && i < nbPulses; ++i) {
+		getPulseKeys(i, keys + nbKeys);
+		nbKeys += keysPerPulse;
+	}
+	std::stable_sort(keys, keys + nbKeys, KeyTimeLess());
+
+	const KeyEntry* right = std::upper_bound(keys, keys + nbKeys, t, KeyTimeLess());
+	assert(right != keys);
+	if (right == keys + nbKeys) {
+		return keys[nbKeys - 1].second;
+	}
+	return interpolate(*(right - 1), *right, t);
+}
+
+ConstMappingIterator* UWBIRPulseMapping::createConstIterator() const
+{
+	const Argument begin(getNbPulses() > 0 ? getPulseStart(0) : signalStart);
+	return new UWBIRPulseMappingIterator(*this, begin);
+}
+
+ConstMappingIterator* UWBIRPulseMapping::createConstIterator(const Argument& pos) const
+{
+	return new UWBIRPulseMappingIterator(*this, pos);
+}
+
+UWBIRPulseMappingIterator::UWBIRPulseMappingIterator(const UWBIRPulseMapping& mapping, const Argument& pos):
+	ConstMappingIterator(), mapping(mapping), pending(), previous(), hasPrevious(false), nextPulse(0),
+	position(), nextPosition()
+{
+	jumpTo(pos);
+}
+
+void UWBIRPulseMappingIterator::fillPending()
+{
+	const size_t nbPulses = mapping.getNbPulses();
+
+	// later pulses can not have a key point before the first pending one
+	while (nextPulse < nbPulses && (pending.empty() || !(pending.front().first < mapping.getPulseStart(nextPulse)))) {
+		KeyEntry keys[UWBIRPulseMapping::keysPerPulse];
+		mapping.getPulseKeys(nextPulse, keys);
+		++nextPulse;
+
+		for (size_t i = 0; i < UWBIRPulseMapping::keysPerPulse; ++i) {
+			std::deque<KeyEntry>::iterator it = std::lower_bound(pending.begin(), pending.end(), keys[i].first, KeyTimeLess());
+			if (it != pending.end() && it->first == keys[i].first) {
+				it->second = keys[i].second;
+			} else {
+				pending.insert(it, keys[i]);
+			}
+		}
+	}
+}
+
+void UWBIRPulseMappingIterator::consumeUntil(simtime_t_cref t)
+{
+	fillPending();
+	while (!pending.empty() && !(t < pending.front().first)) {
+		previous    = pending.front();
+		hasPrevious = true;
+		pending.pop_front();
+		fillPending();
+	}
+}
+
+void UWBIRPulseMappingIterator::updateNextPosition()
+{
+	nextPosition.setTime(pending.empty() ? position.getTime() + 1 : pending.front().first);
+}
+
+void UWBIRPulseMappingIterator::jumpTo(const Argument& pos)
+{
+	const size_t idx = mapping.findPulse(pos.getTime());
+
+	pending.clear();
+	hasPrevious = false;
+	// the pulse before may overlap with the found one
+	nextPulse   = (idx == mapping.getNbPulses() || idx == 0) ? 0 : idx - 1;
+
+	consumeUntil(pos.getTime());
+	position.setTime(pos.getTime());
+	updateNextPosition();
+}
+
+void UWBIRPulseMappingIterator::jumpToBegin()
+{
+	jumpTo(Argument(mapping.getNbPulses() > 0 ? mapping.getPulseStart(0) : mapping.getSignalStart()));
+}
+
+void UWBIRPulseMappingIterator::iterateTo(const Argument& pos)
+{
+	if (pos.getTime() < position.getTime()) {
+		jumpTo(pos);
+		return;
+	}
+	consumeUntil(pos.getTime());
+	position.setTime(pos.getTime());
+	updateNextPosition();
+}
+
+void UWBIRPulseMappingIterator::next()
+{
+	const simtime_t t = nextPosition.getTime();
+
+	consumeUntil(t);
+	position.setTime(t);
+	updateNextPosition();
+}
+
+bool UWBIRPulseMappingIterator::inRange() const
+{
+	return hasPrevious && (!pending.empty() || previous.first == position.getTime());
+}
+
+Mapping::argument_value_t UWBIRPulseMappingIterator::getValue() const
+{
+	if (!hasPrevious) {
+		return pending.empty() ? Argument::MappedZero : pending.front().second;
+	}
+	if (pending.empty()) {
+		return previous.second;
+	}
+	return interpolate(previous, pending.front(), position.getTime());
+}
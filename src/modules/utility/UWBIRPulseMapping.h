@@ -0,0 +1,214 @@
+/* -*- mode:c++ -*- ********************************************************
+ * file:        UWBIRPulseMapping.h
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ * description: procedural pulse-level representation of an IEEE 802.15.4A
+ *              UWB-IR frame
+ ***************************************************************************/
+
+#ifndef _UWBIRPULSEMAPPING_H
+#define _UWBIRPULSEMAPPING_H
+
+#include <vector>
+#include <deque>
+#include <utility>
+
+#include "MiXiMDefs.h"
+#include "Mapping.h"
+#include "IEEE802154A.h"
+#include "UWBIRBitVector.h"
+
+class UWBIRPulseMapping;
+
+/**
+ * @brief ConstMappingIterator implementation for UWBIRPulseMapping.
+ *
+ * Iterates over the start, peak and end points of every pulse of the frame.
+ * The points are generated on the fly, only the points of the pulses around
+ * the current position are kept in memory.
+ *
+ * @ingroup ieee802154a
+ * @ingroup mapping
+ */
+class MIXIM_API UWBIRPulseMappingIterator : public ConstMappingIterator {
+public:
+	/** @brief A key point of the pulse train (position and normalized amplitude).*/
+	typedef std::pair<simtime_t, argument_value_t> KeyEntry;
+
+protected:
+	/** @brief The mapping this iterator iterates over.*/
+	const UWBIRPulseMapping& mapping;
+
+	/** @brief Key points after the current position, sorted by time.*/
+	std::deque<KeyEntry>     pending;
+
+	/** @brief The last key point at or before the current position.*/
+	KeyEntry                 previous;
+
+	/** @brief True if there is a key point at or before the current position.*/
+	bool                     hasPrevious;
+
+	/** @brief Index of the next pulse whose key points have to be added to "pending".*/
+	size_t                   nextPulse;
+
+	/** @brief The current position of the iterator.*/
+	Argument                 position;
+
+	/** @brief The position of the next key point.*/
+	Argument                 nextPosition;
+
+protected:
+	/**
+	 * @brief Adds the key points of the following pulses to "pending" until
+	 * no further pulse can have a key point before the first pending one.
+	 */
+	void fillPending();
+
+	/** @brief Moves all pending key points up to the passed time to "previous".*/
+	void consumeUntil(simtime_t_cref t);
+
+	/** @brief Updates the next position from the pending key points.*/
+	void updateNextPosition();
+
+private:
+	/** @brief Assignment operator is not allowed.
+	 */
+	UWBIRPulseMappingIterator& operator=(const UWBIRPulseMappingIterator&);
+
+public:
+	/** @brief Initializes the iterator at the passed position.*/
+	UWBIRPulseMappingIterator(const UWBIRPulseMapping& mapping, const Argument& pos);
+
+	virtual ~UWBIRPulseMappingIterator() {}
+
+	virtual const Argument& getNextPosition() const { return nextPosition; }
+
+	virtual void jumpTo(const Argument& pos);
+
+	virtual void jumpToBegin();
+
+	virtual void iterateTo(const Argument& pos);
+
+	virtual void next();
+
+	virtual bool inRange() const;
+
+	virtual bool hasNext() const { return !pending.empty(); }
+
+	virtual const Argument& getPosition() const { return position; }
+
+	virtual argument_value_t getValue() const;
+};
+
+/**
+ * @brief Pulse-level representation of an IEEE 802.15.4A UWB-IR frame which
+ * is evaluated on demand.
+ *
+ * Holds only the configuration, the bit values and the time hopping sequence
+ * of the frame. The position of every pulse (sync preamble, SFD and data
+ * bursts) is computed from these when needed, so a frame does not need one
+ * map entry per pulse point anymore.
+ *
+ * The mapping has the same values as the piecewise linear mapping built of
+ * triangular pulses (zero at pulse start and end, peak in the middle) which
+ * was used before.
+ *
+ * @ingroup ieee802154a
+ * @ingroup mapping
+ */
+class MIXIM_API UWBIRPulseMapping : public ConstMapping {
+public:
+	typedef UWBIRPulseMappingIterator::KeyEntry KeyEntry;
+
+	/** @brief Maximum number of key points per pulse.*/
+	static const size_t keysPerPulse = 3;
+
+protected:
+	/** @brief The IEEE 802.15.4A configuration the frame was generated with.*/
+	IEEE802154A::config cfg;
+
+	/** @brief Absolute start time of the frame.*/
+	simtime_t           signalStart;
+
+	/** @brief The modulated bit values.*/
+	UWBIRBitVector      bitValues;
+
+	/** @brief Time hopping position of every data symbol.*/
+	std::vector<short>  hoppingPos;
+
+	/** @brief Positions of the non zero chips of the preamble code.*/
+	std::vector<short>  codePositions;
+
+	/** @brief Indices of the non zero symbols of the SFD.*/
+	std::vector<short>  sfdSymbols;
+
+	/** @brief Number of pulses of the sync preamble.*/
+	size_t              nbPreamblePulses;
+
+	/** @brief Number of pulses of the SFD.*/
+	size_t              nbSfdPulses;
+
+public:
+	/**
+	 * @brief Initializes the mapping for a frame starting at the passed time
+	 * and carrying the passed bit values.
+	 */
+	UWBIRPulseMapping(const IEEE802154A::config& cfg, simtime_t_cref signalStart, const UWBIRBitVector& bitValues);
+
+	virtual ~UWBIRPulseMapping() {}
+
+	/** @brief Returns the total number of pulses of the frame.*/
+	size_t getNbPulses() const {
+		return nbPreamblePulses + nbSfdPulses + bitValues.size() * cfg.nbPulsesPerBurst;
+	}
+
+	/** @brief Returns the absolute start time of the pulse with the passed index.*/
+	simtime_t getPulseStart(size_t idx) const;
+
+	/** @brief Returns the duration of the pulse with the passed index.*/
+	simtime_t getPulseDuration(size_t idx) const;
+
+	/** @brief Returns the absolute time of the peak of the pulse with the passed index.*/
+	simtime_t getPulsePeak(size_t idx) const {
+		return getPulseStart(idx) + getPulseDuration(idx) / 2;
+	}
+
+	/**
+	 * @brief Returns the index of the last pulse which starts at or before the
+	 * passed time or "getNbPulses()" if there is no such pulse.
+	 *
+	 * Has logarithmic complexity over the number of pulses.
+	 */
+	size_t findPulse(simtime_t_cref t) const;
+
+	/**
+	 * @brief Writes the key points (start, peak and end) of the pulse with the
+	 * passed index to the passed array.
+	 */
+	void getPulseKeys(size_t idx, KeyEntry keys[keysPerPulse]) const;
+
+	virtual argument_value_t getValue(const Argument& pos) const;
+
+	virtual ConstMappingIterator* createConstIterator() const;
+
+	virtual ConstMappingIterator* createConstIterator(const Argument& pos) const;
+
+	virtual ConstMapping* constClone() const { return new UWBIRPulseMapping(*this); }
+
+	/** @brief Returns the bit values of the frame.*/
+	const UWBIRBitVector& getBitValues() const { return bitValues; }
+
+	/** @brief Returns the configuration the frame was generated with.*/
+	const IEEE802154A::config& getConfig() const { return cfg; }
+
+	/** @brief Returns the absolute start time of the frame.*/
+	simtime_t_cref getSignalStart() const { return signalStart; }
+};
+
+#endif
@@ -0,0 +1,36 @@
+/***************************************************************************
+ * file:        BaseUtilsTest.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: runs the unit tests for the container classes in base/utils
+ ***************************************************************************/
+
+#include <OmnetTestBase.h>
+
+void testNeighborCache();
+void testSequenceWindow();
+void testTimingWheel();
+void testTraceFileRoundTrip();
+void testTDigest();
+
+class BaseUtilsTest:public SimpleTest {
+protected:
+	void runTests() {
+		testNeighborCache();
+		testSequenceWindow();
+		testTimingWheel();
+		testTraceFileRoundTrip();
+		testTDigest();
+
+		testsExecuted = true;
+	}
+};
+
+Define_Module(BaseUtilsTest);
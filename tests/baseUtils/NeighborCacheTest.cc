@@ -0,0 +1,185 @@
+/***************************************************************************
+ * file:        NeighborCacheTest.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: unit tests for NeighborCache
+ ***************************************************************************/
+
+#include <NeighborCache.h>
+#include <asserts.h>
+
+/** @brief Puts every address into the same bucket to test the chains.*/
+struct SameBucketHash
+{
+	size_t operator()(long) const { return 0; }
+};
+
+typedef NeighborCache<long, int>                 Cache;
+typedef NeighborCache<long, int, SameBucketHash> ChainedCache;
+
+/**
+ * Unit test for the LRU eviction of NeighborCache
+ *
+ * - a full cache replaces the least recently refreshed entry
+ * - refreshing a known entry makes it the most recent one
+ * - lowering the capacity evicts the oldest entries
+ */
+void testNeighborCacheEviction() {
+	Cache cache(3);
+	bool  isNew = false;
+
+	*cache.refresh(1, 1.0) = 10;
+	*cache.refresh(2, 2.0) = 20;
+	*cache.refresh(3, 3.0) = 30;
+	assertEqual("Cache holds three entries.", 3u, cache.size());
+
+	cache.refresh(1, 4.0, &isNew);
+	assertFalse("Refreshing a known address does not create an entry.", isNew);
+	assertEqual("Refreshing keeps the data.", 10, *cache.find(1));
+	assertEqual("Least recently refreshed entry after refreshing 1.", 2L, cache.getOldestKey());
+
+	*cache.refresh(4, 5.0, &isNew) = 40;
+	assertTrue("Refreshing an unknown address creates an entry.", isNew);
+	assertEqual("Full cache keeps its capacity.", 3u, cache.size());
+	assertTrue("Least recently refreshed entry is evicted.", cache.find(2) == NULL);
+	assertTrue("Refreshed entry survives eviction.", cache.find(1) != NULL);
+	assertEqual("Next entry to evict.", 3L, cache.getOldestKey());
+	assertClose("Refresh time of the next entry to evict.", 3.0, SIMTIME_DBL(cache.getOldestRefresh()));
+
+	cache.setCapacity(1);
+	assertEqual("Lowering the capacity evicts entries.", 1u, cache.size());
+	assertEqual("Most recent entry is kept.", 40, *cache.find(4));
+
+	Cache none(0);
+	assertTrue("Cache with capacity zero stores nothing.", none.refresh(1, 1.0) == NULL);
+
+	std::cout << "NeighborCache eviction tests successful." << std::endl;
+}
+
+/**
+ * Unit test for growing of NeighborCache
+ *
+ * - all entries are found with their data after the tables grew
+ * - the LRU order is unchanged by the rehashing
+ */
+void testNeighborCacheGrow() {
+	Cache cache;
+	const long nbEntries = 20; // grows from 8 to 16 to 32 nodes
+
+	for (long i = 0; i < nbEntries; ++i) {
+		*cache.refresh(i, i) = static_cast<int>(i * 10);
+		if (i == 4) {
+			// refresh an older entry before the first growth
+			cache.refresh(1, i + 0.5);
+		}
+	}
+	assertEqual("Unbounded cache holds every entry.", static_cast<size_t>(nbEntries), cache.size());
+
+	bool allFound = true;
+	for (long i = 0; i < nbEntries; ++i) {
+		const int* value = cache.find(i);
+		allFound = allFound && value != NULL && *value == i * 10;
+	}
+	assertTrue("Every entry is found with its data after growing.", allFound);
+
+	// expire one entry after the other, they have to leave in LRU order
+	const long expected[] = { 0, 2, 3, 4, 1, 5, 6, 7, 8, 9 };
+	bool       inOrder    = true;
+	for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+		inOrder = inOrder && cache.getOldestKey() == expected[i];
+		cache.expire(cache.getOldestRefresh());
+	}
+	assertTrue("LRU order is kept when growing.", inOrder);
+	assertEqual("Entries left after expiring.", 10u, cache.size());
+
+	std::cout << "NeighborCache grow tests successful." << std::endl;
+}
+
+/**
+ * Unit test for the age expiry of NeighborCache
+ *
+ * - expire() removes entries refreshed at or before the passed time
+ * - findFresh() only returns entries refreshed after the passed time
+ */
+void testNeighborCacheExpire() {
+	Cache cache;
+
+	cache.refresh(1, 1.0);
+	cache.refresh(2, 2.0);
+	cache.refresh(3, 3.0);
+
+	assertEqual("Nothing is refreshed before 1.", 0u, cache.expire(0.5));
+	assertEqual("Entries refreshed at the passed time expire.", 2u, cache.expire(2.0));
+	assertTrue("Entry refreshed at 1 expired.", cache.find(1) == NULL);
+	assertTrue("Entry refreshed at 2 expired.", cache.find(2) == NULL);
+	assertTrue("Entry refreshed at 3 is kept.", cache.find(3) != NULL);
+	assertEqual("Entries refreshed after the passed time are kept.", 0u, cache.expire(2.999));
+
+	assertTrue("Entry refreshed at the passed time is not fresh.", cache.findFresh(3, 3.0) == NULL);
+	assertTrue("Entry refreshed after the passed time is fresh.", cache.findFresh(3, 2.9) != NULL);
+	assertTrue("Unknown entry is not fresh.", cache.findFresh(4, 0.0) == NULL);
+
+	assertEqual("Expiring everything.", 1u, cache.expire(3.0));
+	assertTrue("Cache is empty after expiring everything.", cache.empty());
+
+	std::cout << "NeighborCache expire tests successful." << std::endl;
+}
+
+/**
+ * Unit test for removing entries of NeighborCache
+ *
+ * - erase the head, the tail and the middle of a bucket chain
+ * - erase the newest and the oldest entry of the LRU list
+ * - freed nodes are reused
+ */
+void testNeighborCacheErase() {
+	ChainedCache cache;
+
+	// the chain is 3 -> 2 -> 1, the LRU list 1 (oldest) ... 3 (newest)
+	*cache.refresh(1, 1.0) = 10;
+	*cache.refresh(2, 2.0) = 20;
+	*cache.refresh(3, 3.0) = 30;
+
+	assertFalse("Erasing an unknown address.", cache.erase(4));
+	assertTrue("Erasing the chain head.", cache.erase(3));
+	assertTrue("Chain head is gone.", cache.find(3) == NULL);
+	assertEqual("Middle entry is found after erasing the head.", 20, *cache.find(2));
+	assertEqual("Tail entry is found after erasing the head.", 10, *cache.find(1));
+
+	assertTrue("Erasing the chain tail.", cache.erase(1));
+	assertTrue("Chain tail is gone.", cache.find(1) == NULL);
+	assertEqual("Remaining entry is found after erasing the tail.", 20, *cache.find(2));
+	assertEqual("Oldest entry after erasing the oldest one.", 2L, cache.getOldestKey());
+
+	// the chain is 5 -> 4 -> 2, freed nodes are reused
+	*cache.refresh(4, 4.0) = 40;
+	*cache.refresh(5, 5.0) = 50;
+	assertTrue("Erasing the chain middle.", cache.erase(4));
+	assertEqual("Chain head is found after erasing the middle.", 50, *cache.find(5));
+	assertEqual("Chain tail is found after erasing the middle.", 20, *cache.find(2));
+	assertEqual("Cache size after erasing.", 2u, cache.size());
+
+	assertTrue("Erasing the newest entry.", cache.erase(5));
+	assertEqual("Oldest entry after erasing the newest one.", 2L, cache.getOldestKey());
+	assertTrue("Erasing the last entry.", cache.erase(2));
+	assertTrue("Cache is empty.", cache.empty());
+
+	*cache.refresh(6, 6.0) = 60;
+	assertEqual("Erased cache is usable again.", 60, *cache.find(6));
+
+	std::cout << "NeighborCache erase tests successful." << std::endl;
+}
+
+void testNeighborCache() {
+	testNeighborCacheEviction();
+	testNeighborCacheGrow();
+	testNeighborCacheExpire();
+	testNeighborCacheErase();
+}
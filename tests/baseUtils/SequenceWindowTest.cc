@@ -0,0 +1,90 @@
+/***************************************************************************
+ * file:        SequenceWindowTest.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: unit tests for SequenceWindow
+ ***************************************************************************/
+
+#include <SequenceWindow.h>
+#include <asserts.h>
+
+/**
+ * Unit test for in order, out of order and duplicate sequence numbers
+ */
+void testSequenceWindowOrder() {
+	SequenceWindow window;
+
+	assertFalse("Nothing is seen before the first packet.", window.isSeen(0));
+	assertTrue("First sequence number is accepted.", window.accept(10));
+	assertFalse("First sequence number is a duplicate.", window.accept(10));
+	assertFalse("Higher sequence number is not seen.", window.isSeen(11));
+
+	assertTrue("Skipping sequence numbers.", window.accept(13));
+	assertEqual("Highest sequence number.", 13ul, window.getHighest());
+	assertTrue("Old highest is seen.", window.isSeen(10));
+	assertFalse("Skipped sequence number is not seen.", window.isSeen(12));
+	assertTrue("Late sequence number is accepted.", window.accept(11));
+	assertFalse("Late sequence number is a duplicate.", window.accept(11));
+	assertFalse("Other skipped sequence number is still unseen.", window.isSeen(12));
+
+	std::cout << "SequenceWindow order tests successful." << std::endl;
+}
+
+/**
+ * Unit test for the edges of the window
+ *
+ * - a shift of exactly WINDOW_SIZE keeps the old highest in the last bit
+ * - a shift of more than WINDOW_SIZE drops the whole window
+ * - distance WINDOW_SIZE is the oldest tracked sequence number,
+ *   everything older is considered as seen
+ */
+void testSequenceWindowEdges() {
+	const unsigned long size = SequenceWindow::WINDOW_SIZE;
+
+	SequenceWindow exact;
+	exact.accept(100);
+	exact.accept(99); // out of the window after the shift
+	assertTrue("Shift by exactly the window size.", exact.accept(100 + size));
+	assertTrue("Old highest is the oldest tracked number.", exact.isSeen(100));
+	assertFalse("Old highest is a duplicate.", exact.accept(100));
+	assertFalse("Numbers between are not seen.", exact.isSeen(101));
+	assertFalse("Number right below the new highest is not seen.", exact.isSeen(99 + size));
+	assertTrue("Number right below the new highest is accepted.", exact.accept(99 + size));
+	assertTrue("Number behind the window counts as seen.", exact.isSeen(99));
+
+	SequenceWindow beyond;
+	beyond.accept(100);
+	beyond.accept(102);
+	assertTrue("Shift by more than the window size.", beyond.accept(102 + size + 1));
+	assertTrue("Old highest at distance window size + 1 counts as seen.", beyond.isSeen(102));
+	assertFalse("Number at distance window size is not seen.", beyond.isSeen(103));
+	assertTrue("Number at distance window size is accepted.", beyond.accept(103));
+	assertTrue("Number at distance window size is seen.", beyond.isSeen(103));
+	assertFalse("Number at distance window size is a duplicate.", beyond.accept(103));
+	bool anySeen = false;
+	for (unsigned long seq = 104; seq < 102 + size + 1; ++seq) {
+		anySeen = anySeen || beyond.isSeen(seq);
+	}
+	assertFalse("Dropped window holds no seen numbers.", anySeen);
+
+	SequenceWindow huge;
+	huge.accept(0);
+	huge.accept(1);
+	assertTrue("Shift by many times the window size.", huge.accept(10 * size));
+	assertFalse("Number right below the new highest is not seen.", huge.isSeen(10 * size - 1));
+	assertTrue("Number long before the window counts as seen.", huge.isSeen(1));
+
+	std::cout << "SequenceWindow edge tests successful." << std::endl;
+}
+
+void testSequenceWindow() {
+	testSequenceWindowOrder();
+	testSequenceWindowEdges();
+}
@@ -0,0 +1,91 @@
+/***************************************************************************
+ * file:        TDigestTest.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: unit tests for TDigest
+ ***************************************************************************/
+
+#include <cmath>
+#include <sstream>
+
+#include <TDigest.h>
+#include <asserts.h>
+
+/** @brief Number of values of the known distributions.*/
+static const long NB_VALUES = 100000;
+
+/**
+ * @brief Returns the i-th index of a fixed permutation of [0, NB_VALUES),
+ * so the values are not added in sorted order.
+ */
+static long permuted(long i) {
+	// 7919 is prime and does not divide NB_VALUES
+	return (i * 7919) % NB_VALUES;
+}
+
+/** @brief Checks the estimated quantiles against the exact ones within a tolerance.*/
+static void assertQuantiles(std::string msg, TDigest& digest, double (*exact)(double), double tolerance) {
+	static const double qs[] = { 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99 };
+
+	for (size_t i = 0; i < sizeof(qs) / sizeof(qs[0]); ++i) {
+		std::ostringstream name;
+		name << msg << " " << qs[i] * 100 << "% quantile.";
+		const double expected  = exact(qs[i]);
+		const double estimated = digest.quantile(qs[i]);
+		if (std::fabs(estimated - expected) <= tolerance * std::fabs(expected))
+			pass(name.str());
+		else
+			fail(name.str(), expected, estimated);
+	}
+}
+
+static double uniformQuantile(double q) { return q * (NB_VALUES - 1); }
+static double exponentialQuantile(double q) { return -std::log(1 - q); }
+
+/**
+ * Unit test for the quantiles of TDigest
+ *
+ * - no values: NaN
+ * - few values: the exact median and the extremes
+ * - uniform and exponential distributions: the quantiles 1% ... 99%
+ *   within 1% of the exact ones
+ */
+void testTDigest() {
+	TDigest digest;
+	const double empty = digest.quantile(0.5);
+	assertTrue("Quantile without values is NaN.", empty != empty);
+
+	const double few[] = { 4, 1, 5, 3, 2 };
+	for (size_t i = 0; i < 5; ++i) {
+		digest.add(few[i]);
+	}
+	assertEqual("Number of values.", 5.0, digest.getCount());
+	assertClose("Median of few values.", 3.0, digest.quantile(0.5));
+	assertEqual("0% quantile is the minimum.", 1.0, digest.quantile(0));
+	assertEqual("100% quantile is the maximum.", 5.0, digest.quantile(1));
+
+	digest.clear();
+	assertEqual("No values after clearing.", 0.0, digest.getCount());
+	for (long i = 0; i < NB_VALUES; ++i) {
+		digest.add(static_cast<double>(permuted(i)));
+	}
+	assertEqual("Number of uniform values.", static_cast<double>(NB_VALUES), digest.getCount());
+	assertQuantiles("Uniform", digest, uniformQuantile, 0.01);
+	assertEqual("Minimum of uniform values.", 0.0, digest.quantile(0));
+	assertEqual("Maximum of uniform values.", NB_VALUES - 1.0, digest.quantile(1));
+
+	TDigest exponential;
+	for (long i = 0; i < NB_VALUES; ++i) {
+		exponential.add(exponentialQuantile((permuted(i) + 0.5) / NB_VALUES));
+	}
+	assertQuantiles("Exponential", exponential, exponentialQuantile, 0.01);
+
+	std::cout << "TDigest tests successful." << std::endl;
+}
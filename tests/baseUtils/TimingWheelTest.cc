@@ -0,0 +1,138 @@
+/***************************************************************************
+ * file:        TimingWheelTest.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: unit tests for TimingWheel
+ ***************************************************************************/
+
+#include <TimingWheel.h>
+#include <asserts.h>
+
+typedef TimingWheel<int> Wheel;
+
+/** @brief Pops all elements and checks them against the expected values.*/
+static void assertPopOrder(std::string msg, Wheel& wheel, const int* expected, size_t nb) {
+	bool inOrder = wheel.size() == nb;
+	for (size_t i = 0; inOrder && i < nb; ++i) {
+		inOrder = wheel.pop_front() == expected[i];
+	}
+	assertTrue(msg, inOrder && wheel.empty());
+}
+
+/**
+ * Unit test for elements due after the range of the wheel
+ *
+ * - elements in the overflow level are returned in time order
+ * - elements are moved into the wheel as it turns
+ * - elements inserted after turning go to the wheel or the overflow level
+ */
+void testTimingWheelOverflow() {
+	Wheel wheel(1, 4); // covers 4s
+
+	wheel.insert(10.0, 10);
+	wheel.insert(2.0,   2);
+	wheel.insert(7.0,   7);
+	wheel.insert(20.0, 20);
+	wheel.insert(5.5,   5);
+	assertEqual("Size after inserting.", 5u, wheel.size());
+	assertClose("Earliest due time.", 2.0, SIMTIME_DBL(wheel.getFirstTime()));
+	assertEqual("Earliest element.", 2, wheel.front());
+	assertEqual("Earliest element again.", 2, wheel.front());
+
+	assertEqual("Pop element within the wheel.", 2, wheel.pop_front());
+	assertEqual("Pop first element of the overflow level.", 5, wheel.pop_front());
+	assertEqual("Pop cascaded element.", 7, wheel.pop_front());
+
+	// the wheel now covers [7, 11)
+	wheel.insert(9.0,   9);
+	wheel.insert(12.0, 12);
+	assertClose("Earliest due time after turning.", 9.0, SIMTIME_DBL(wheel.getFirstTime()));
+	const int order[] = { 9, 10, 12, 20 };
+	assertPopOrder("Remaining elements in time order.", wheel, order, 4);
+
+	std::cout << "TimingWheel overflow tests successful." << std::endl;
+}
+
+/**
+ * Unit test for the order of elements due at the same time or early
+ *
+ * - elements with the same due time are returned in insertion order
+ * - elements inserted at the time of the last popped one come next
+ * - elements due before the current slot are returned first
+ */
+void testTimingWheelOrder() {
+	Wheel wheel(1, 4);
+
+	wheel.insert(1.5, 1);
+	wheel.insert(1.5, 2);
+	wheel.insert(1.2, 0);
+	wheel.insert(9.5, 8); // overflow
+	wheel.insert(1.5, 3);
+	wheel.insert(9.5, 9);
+	const int sameTime[] = { 0, 1, 2, 3, 8, 9 };
+	assertPopOrder("Same due time in insertion order.", wheel, sameTime, 6);
+
+	wheel.insert(6.5, 1);
+	wheel.insert(6.7, 3);
+	assertEqual("Turn the wheel.", 1, wheel.pop_front());
+	wheel.insert(6.5, 2);
+	assertEqual("Element due at the time of the last popped one.", 2, wheel.pop_front());
+
+	wheel.insert(6.6, 4);
+	wheel.insert(3.0, 5);
+	assertClose("Element due before the current slot is the earliest.", 3.0, SIMTIME_DBL(wheel.getFirstTime()));
+	const int early[] = { 5, 4, 3 };
+	assertPopOrder("Elements due in and before the current slot.", wheel, early, 3);
+
+	std::cout << "TimingWheel order tests successful." << std::endl;
+}
+
+/**
+ * Unit test for clear() and setGeometry()
+ *
+ * - a cleared wheel starts over at time zero
+ * - a wheel with a new geometry orders and cascades its elements
+ */
+void testTimingWheelGeometry() {
+	Wheel wheel(1, 4);
+
+	wheel.insert(30.0, 30);
+	wheel.insert(31.0, 31);
+	assertEqual("Turn the wheel far.", 30, wheel.pop_front());
+	wheel.clear();
+	assertTrue("Cleared wheel is empty.", wheel.empty());
+
+	wheel.insert(2.0, 2);
+	wheel.insert(1.0, 1);
+	wheel.insert(3.0, 3);
+	const int cleared[] = { 1, 2, 3 };
+	assertPopOrder("Elements after clearing in time order.", wheel, cleared, 3);
+
+	wheel.setGeometry(0.5, 2); // covers 1s
+	wheel.insert(4.0,  4);
+	wheel.insert(0.25, 0);
+	wheel.insert(2.0,  2);
+	wheel.insert(0.75, 1);
+	wheel.insert(2.0,  3);
+	assertEqual("Size after changing the geometry.", 5u, wheel.size());
+	const int geometry[] = { 0, 1, 2, 3, 4 };
+	assertPopOrder("Elements after changing the geometry in time order.", wheel, geometry, 5);
+
+	wheel.insert(5.0, 5);
+	assertEqual("Wheel keeps turning after changing the geometry.", 5, wheel.pop_front());
+
+	std::cout << "TimingWheel geometry tests successful." << std::endl;
+}
+
+void testTimingWheel() {
+	testTimingWheelOverflow();
+	testTimingWheelOrder();
+	testTimingWheelGeometry();
+}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ * file:        TraceFileTest.cc
+ *
+ *              This program is free software; you can redistribute it
+ *              and/or modify it under the terms of the GNU General Public
+ *              License as published by the Free Software Foundation; either
+ *              version 2 of the License, or (at your option) any later
+ *              version.
+ *              For further information see file COPYING
+ *              in the top level directory
+ ***************************************************************************
+ * description: write/read round trip test for TraceChannel and
+ *              TraceFileReader
+ ***************************************************************************/
+
+#include <cstdio>
+
+#include <TraceFile.h>
+#include <asserts.h>
+
+static const char* const TRACE_DIR  = "baseUtilsTrace";
+static const char* const TRACE_FILE = "baseUtilsTrace/baseUtilsTest.trace";
+
+/** @brief Reads the next block and compares it with the expected samples.*/
+static void assertBlock(std::string msg, TraceFileReader& reader, const std::string& expChannel,
+                        const double* expTimes, const double* expValues, size_t nb)
+{
+	std::string         channel;
+	std::vector<int64>  rawTimes;
+	std::vector<double> values;
+
+	assertTrue(msg + " Block is read.", reader.readBlock(channel, rawTimes, values));
+	assertEqual(msg + " Channel name.", expChannel, channel);
+	assertEqual(msg + " Number of samples.", nb, rawTimes.size());
+
+	bool same = rawTimes.size() == nb && values.size() == nb;
+	for (size_t i = 0; same && i < nb; ++i) {
+		same = rawTimes[i] == SIMTIME_RAW(simtime_t(expTimes[i])) && values[i] == expValues[i];
+	}
+	assertTrue(msg + " Samples are unchanged.", same);
+}
+
+/**
+ * Write/read round trip of a trace file
+ *
+ * - two channels share one file, blocks of both are read back in the
+ *   order they were written
+ * - a block is written as soon as blockSize samples are buffered, the
+ *   rest when the channel is closed
+ * - decreasing and negative times (negative time differences) survive
+ * - the missing directory of the file is created
+ */
+void testTraceFileRoundTrip() {
+	TraceChannel pulses;
+	TraceChannel thresholds;
+
+	pulses.open(TRACE_FILE, "pulses", 3);
+	thresholds.open(TRACE_FILE, "thresholds");
+	assertTrue("Opened channel is enabled.", pulses.isEnabled());
+
+	const double pulseTimes[]  = { 1.0, 0.5, 2.0, 3.0, -1.0 };
+	const double pulseValues[] = { 0.1, -2.5, 1e300, 0.0, 42.0 };
+	for (size_t i = 0; i < 5; ++i) {
+		pulses.record(pulseTimes[i], pulseValues[i]); // the first three are written at once
+	}
+	const double threshTimes[]  = { 0.25, 0.25 };
+	const double threshValues[] = { 7.0, 8.0 };
+	for (size_t i = 0; i < 2; ++i) {
+		thresholds.record(threshTimes[i], threshValues[i]);
+	}
+	thresholds.close();
+	pulses.close();
+	assertFalse("Closed channel is disabled.", pulses.isEnabled());
+	pulses.record(4.0, 1.0); // ignored
+
+	TraceFileReader reader;
+	assertTrue("Trace file is opened.", reader.open(TRACE_FILE));
+	assertEqual("Time scale exponent.", SimTime::getScaleExp(), reader.getScaleExp());
+	assertBlock("Full block:", reader, "pulses", pulseTimes, pulseValues, 3);
+	assertBlock("Block of the other channel:", reader, "thresholds", threshTimes, threshValues, 2);
+	assertBlock("Rest flushed on close:", reader, "pulses", pulseTimes + 3, pulseValues + 3, 2);
+
+	std::string         channel;
+	std::vector<int64>  rawTimes;
+	std::vector<double> values;
+	assertFalse("No more blocks.", reader.readBlock(channel, rawTimes, values));
+
+	std::remove(TRACE_FILE);
+	std::remove(TRACE_DIR);
+	assertFalse("Missing file is not opened.", reader.open(TRACE_FILE));
+
+	std::cout << "TraceFile round trip tests successful." << std::endl;
+}
@@ -14,6 +14,8 @@
 //
 
 #include "TestCM.h"
+
+#include <cmath>
 #include <asserts.h>
 
 Define_Module(TestCM);
@@ -30,26 +32,45 @@ void TestCM::updateConnections(int nicID, const Coord* oldPos, const Coord* newP
 	displayPassed = false;
 	assertTrue("NicID should exists.", nic != 0);
 
+	checkConnections(nic, false);
+	displayPassed = true;
+}
+
+void TestCM::kineticConnectionsUpdated() {
+	displayPassed = false;
+	for(NicEntries::iterator i = nics.begin(); i != nics.end(); ++i)
+	{
+		checkConnections(i->second, true);
+	}
+	displayPassed = true;
+}
+
+void TestCM::checkConnections(NicEntry* nic, bool skipBorder) {
+	const Coord pos = getCurrentNicPos(nic);
+
 	for(NicEntries::iterator i = nics.begin(); i != nics.end(); ++i)
 	{
 		NicEntry* nic_i = i->second;
 
 		// no recursive connections
-		if ( nic_i->nicId == nicID ) continue;
+		if ( nic_i->nicId == nic->nicId ) continue;
 
 		double distance;
 
 		if(useTorus)
 		{
-			distance = nic->pos.sqrTorusDist(nic_i->pos, *playgroundSize);
+			distance = pos.sqrTorusDist(getCurrentNicPos(nic_i), *playgroundSize);
 		} else {
-			distance = nic->pos.sqrdist(nic_i->pos);
+			distance = pos.sqrdist(getCurrentNicPos(nic_i));
 		}
 
+		// kinetic events are rounded to the simulation time resolution,
+		// pairs right at the border of the range may be either way
+		if(skipBorder && fabs(sqrt(distance) - maxInterferenceDistance) < 1e-6) continue;
+
 		bool inRange = (distance <= maxDistSquared);
 		bool connected = nic->isConnected(nic_i);
 
 		assertEqual("Nics in range should be connected.", inRange, connected);
 	}
-	displayPassed = true;
 }
@@ -22,12 +22,22 @@
 /**
  * @brief Checks after every update of the connection if the
  * hosts are connected correctly by checking every single host pair.
+ *
+ * In kinetic mode the check runs for all host pairs after every
+ * position update and every kinetic event.
  */
 class TestCM : public BaseConnectionManager
 {
 protected:
 	virtual double calcInterfDist();
 	virtual void updateConnections(int nicID, const Coord* oldPos, const Coord* newPos);
+
+	/** @brief The range check is not changed, so kinetic mode can be tested.*/
+	virtual bool supportsKineticConnections() const { return true; }
+	virtual void kineticConnectionsUpdated();
+
+	/** @brief Checks the connections between "nic" and every other nic.*/
+	void checkConnections(NicEntry* nic, bool skipBorder);
 };
 
 #endif
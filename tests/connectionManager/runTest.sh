@@ -47,6 +47,8 @@ fi
 ./${lSingle} -c Test2 "${LIBSREF[@]}">> out.tmp 2>> err.tmp
 ./${lSingle} -c Test3 "${LIBSREF[@]}">> out.tmp 2>> err.tmp
 ./${lSingle} -c Test4 "${LIBSREF[@]}">> out.tmp 2>> err.tmp
+# moving nics, the output depends on the random trajectories
+./${lSingle} -c Kinetic "${LIBSREF[@]}">  kinetic.tmp 2>> err.tmp
 
 [ x$lIsComb = x1 ] && rm -f ${lSingle} ${lSingle}.exe >/dev/null 2>&1
 diff -I '^Assigned runID=' \
@@ -63,8 +65,11 @@ if [ -s diff.log ]; then
     [ "$1" = "update-exp-output" ] && \
         cat out.tmp >exp-output
     exit 1
+elif ! grep -q -e '^Passed' kinetic.tmp || grep -q -e '^FAILED' kinetic.tmp; then
+    echo "FAILED kinetic connections; see $(basename $(cd $(dirname $0);pwd) )/kinetic.tmp"
+    exit 1
 else
     echo "PASSED $(basename $(cd $(dirname $0);pwd) )"
-    rm -f out.tmp diff.log err.tmp
+    rm -f out.tmp diff.log err.tmp kinetic.tmp
 fi
 exit 0
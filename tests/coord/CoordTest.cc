@@ -16,6 +16,7 @@
  ***************************************************************************/
 
 #include <Coord.h>
+#include <PlainCoord.h>
 #include <asserts.h>
 #include <OmnetTestBase.h>
 
@@ -368,6 +369,114 @@ void testIsInBoundary() {
 	std::cout << "Is in rectangle test successful." << std::endl;
 }
 
+/**
+ * @brief Positions for the PlainCoord and CoordBatch tests: inside the
+ * playground, on its borders, across the wrap-around and outside of it.
+ */
+static std::vector<Coord> distancePositions(bool is2D) {
+	const double pos[][3] = {
+		{ X, Y, Z },
+		{ X2, Y2, Z2 },
+		{ X1_IN_UPPER_LEFT_HALF, Y1_IN_UPPER_LEFT_HALF, Z1_IN_UPPER_LEFT_HALF },
+		{ X2_IN_UPPER_LEFT_HALF, Y2_IN_UPPER_LEFT_HALF, Z2_IN_UPPER_LEFT_HALF },
+		{ X1_IN_LOWER_RIGHT_HALF, Y1_IN_LOWER_RIGHT_HALF, Z1_IN_LOWER_RIGHT_HALF },
+		{ 0.1, PG_Y - 0.1, 0.0 },
+		{ PG_X - 0.1, 0.1, PG_Z },
+		{ 0.0, 0.0, 0.0 },
+		{ PG_X, PG_Y, PG_Z },
+		{ BIGGER + PG_X, SMALLER, 2 * BIGGER }
+	};
+	std::vector<Coord> positions;
+	for (size_t i = 0; i < sizeof(pos) / sizeof(pos[0]); ++i) {
+		positions.push_back(is2D ? Coord(pos[i][0], pos[i][1]) : Coord(pos[i][0], pos[i][1], pos[i][2]));
+	}
+	return positions;
+}
+
+/** @brief Returns true if both distances are equal up to a relative tolerance.*/
+static bool sameDistance(double expected, double actual) {
+	return fabs(expected - actual) <= TOLERANCE * std::max(1.0, fabs(expected));
+}
+
+/**
+ * @brief Compares the distances of PlainCoord and both CoordBatch kernels
+ * with the ones of Coord for all pairs of the passed positions.
+ */
+static void testPlainCoordDistances(std::string prefix, const std::vector<Coord>& positions, const Coord& pg) {
+	bool sameSqrDist    = true;
+	bool sameDist       = true;
+	bool sameTorusDist  = true;
+	bool sameBatch      = true;
+	bool sameBatchTorus = true;
+
+	CoordBatch batch;
+	for (size_t j = 0; j < positions.size(); ++j) {
+		batch.push_back(positions[j]);
+	}
+	std::vector<double> sqrDists(positions.size());
+	std::vector<double> torusDists(positions.size());
+
+	for (size_t i = 0; i < positions.size(); ++i) {
+		const Coord&     a  = positions[i];
+		const PlainCoord pa = a;
+
+		batch.sqrDistances(pa, &sqrDists[0]);
+		batch.sqrTorusDistances(pa, PlainCoord(pg), &torusDists[0]);
+
+		for (size_t j = 0; j < positions.size(); ++j) {
+			const Coord&     b  = positions[j];
+			const PlainCoord pb = b;
+
+			sameSqrDist    = sameSqrDist    && sameDistance(a.sqrdist(b), pa.sqrdist(pb));
+			sameDist       = sameDist       && sameDistance(a.distance(b), pa.distance(pb));
+			sameTorusDist  = sameTorusDist  && sameDistance(a.sqrTorusDist(b, pg), pa.sqrTorusDist(pb, pg));
+			sameBatch      = sameBatch      && sameDistance(b.sqrdist(a), sqrDists[j]);
+			sameBatchTorus = sameBatchTorus && sameDistance(b.sqrTorusDist(a, pg), torusDists[j]);
+		}
+	}
+	assertTrue(prefix + "PlainCoord square distances equal the ones of Coord.", sameSqrDist);
+	assertTrue(prefix + "PlainCoord distances equal the ones of Coord.", sameDist);
+	assertTrue(prefix + "PlainCoord torus distances equal the ones of Coord.", sameTorusDist);
+	assertTrue(prefix + "CoordBatch square distances equal the ones of Coord.", sameBatch);
+	assertTrue(prefix + "CoordBatch torus distances equal the ones of Coord.", sameBatchTorus);
+}
+
+/**
+ * Unit test for PlainCoord and CoordBatch
+ *
+ * - distances, square distances and torus distances equal the ones of Coord
+ * - torus distances across the wrap-around and of positions outside of the
+ *   playground
+ * - 2D positions on a playground with a z size of zero
+ * - conversion from and to Coord
+ * - empty batch
+ */
+void testPlainCoord() {
+	testPlainCoordDistances("3D: ", distancePositions(false), Coord(PG_X, PG_Y, PG_Z));
+	testPlainCoordDistances("2D: ", distancePositions(true), Coord(PG_X, PG_Y));
+
+	const PlainCoord wrap1(0.1, PG_Y - 0.1);
+	const PlainCoord wrap2(PG_X - 0.1, 0.1);
+	assertClose("Torus distance across the wrap-around.", 0.2 * 0.2 + 0.2 * 0.2,
+	            wrap1.sqrTorusDist(wrap2, PlainCoord(PG_X, PG_Y)));
+	assertClose("Torus distance on an axis of size zero.", 0.0,
+	            PlainCoord::torusAxisDist(1.0, 1.0, 0.0));
+
+	const Coord      c(X, Y, Z);
+	const PlainCoord pc = c;
+	assertTrue("Conversion from and to Coord.", pc.toCoord() == c);
+
+	CoordBatch empty;
+	assertTrue("Empty batch.", empty.empty());
+	empty.sqrDistances(pc, NULL);
+	empty.sqrTorusDistances(pc, PlainCoord(PG_X, PG_Y, PG_Z), NULL);
+	empty.push_back(pc);
+	empty.clear();
+	assertEqual("Cleared batch.", (size_t)0, empty.size());
+
+	std::cout << "PlainCoord and CoordBatch test successful." << std::endl;
+}
+
 class CoordTest:public SimpleTest {
 protected:
 	void runTests() {
@@ -377,6 +486,7 @@ protected:
 	    testLength();
 	    testDistance();
 	    testIsInBoundary();
+	    testPlainCoord();
 
 	    testsExecuted = true;
 	}
@@ -2631,8 +2631,110 @@ protected:
 		delete multi1;
 	}
 
+	void testTimeFreqGrid() {
+		DimensionSet timeFreq(time, freq);
+
+		TimeFreqGridMapping::FreqAxis freqs;
+		for(int f = 1; f < 5; ++f)
+			freqs.push_back(f);
+
+		Mapping* grid  = new TimeFreqGridMapping(freqs, 0.0);
+		Mapping* multi = MappingUtils::createMapping(0.0, timeFreq);
+		for(int t = 1; t < 5; ++t) {
+			for(int f = 1; f < 5; ++f) {
+				grid->setValue(A(f, t), t * 10 + f);
+				multi->setValue(A(f, t), t * 10 + f);
+			}
+		}
+
+		//values on and between the grid points as well as out of range
+		for(double t = 0.5; t <= 5.0; t += 0.25) {
+			for(double f = 0.5; f <= 5.0; f += 0.25) {
+				assertClose("Grid value at (" + toString(t) + "," + toString(f) + ").",
+				            multi->getValue(A(f, t)), grid->getValue(A(f, t)));
+			}
+		}
+
+		//iteration order has to be the same as the one of MultiDimMapping
+		ConstMappingIterator* itGrid  = grid->createConstIterator();
+		ConstMappingIterator* itMulti = multi->createConstIterator();
+		while(itMulti->inRange()) {
+			assertTrue("Grid iterator in range.", itGrid->inRange());
+			assertClose("Grid iterator position.", itMulti->getPosition(), itGrid->getPosition());
+			assertClose("Grid iterator value.", itMulti->getValue(), itGrid->getValue());
+			assertEqual("Grid iterator hasNext.", itMulti->hasNext(), itGrid->hasNext());
+			if(!itMulti->hasNext())
+				break;
+			itMulti->next();
+			itGrid->next();
+		}
+		delete itGrid;
+		delete itMulti;
+
+		//element wise operators with a time only mapping
+		Mapping* timed = MappingUtils::createMapping(0.0);
+		timed->setValue(A(1.5), 2);
+		timed->setValue(A(3), 4);
+
+		Mapping* gridRes  = MappingUtils::multiply(*grid, *timed, 0.0);
+		Mapping* multiRes = MappingUtils::multiply(*multi, *timed, 0.0);
+		for(double t = 0.5; t <= 5.0; t += 0.25) {
+			for(double f = 0.5; f <= 5.0; f += 0.25) {
+				assertClose("Grid product at (" + toString(t) + "," + toString(f) + ").",
+				            multiRes->getValue(A(f, t)), gridRes->getValue(A(f, t)));
+			}
+		}
+		delete gridRes;
+		delete multiRes;
+
+		//a grid as second operand is combined as grid as well
+		gridRes  = MappingUtils::subtract(*timed, *grid, 0.0);
+		multiRes = MappingUtils::subtract(*timed, *multi, 0.0);
+		assertTrue("Grid as second operand results in a grid.",
+		           dynamic_cast<TimeFreqGridMapping*>(gridRes) != 0);
+		for(double t = 0.5; t <= 5.0; t += 0.25) {
+			for(double f = 0.5; f <= 5.0; f += 0.25) {
+				assertClose("Grid as second operand at (" + toString(t) + "," + toString(f) + ").",
+				            multiRes->getValue(A(f, t)), gridRes->getValue(A(f, t)));
+			}
+		}
+		delete gridRes;
+		delete multiRes;
+
+		//element wise operators with another grid
+		gridRes  = MappingUtils::add(*grid, *grid);
+		multiRes = MappingUtils::add(*multi, *multi);
+		for(double t = 0.5; t <= 5.0; t += 0.25) {
+			for(double f = 1.0; f <= 4.0; f += 0.25) {
+				assertClose("Grid sum at (" + toString(t) + "," + toString(f) + ").",
+				            multiRes->getValue(A(f, t)), gridRes->getValue(A(f, t)));
+			}
+		}
+		delete gridRes;
+		delete multiRes;
+
+		//ranged minimum and maximum
+		for(int t1 = 1; t1 < 5; ++t1) {
+			for(int t2 = t1; t2 < 5; ++t2) {
+				for(int f1 = 1; f1 < 5; ++f1) {
+					for(int f2 = f1; f2 < 5; ++f2) {
+						assertEqual("Grid min.", MappingUtils::findMin(*multi, A(f1, t1), A(f2, t2)),
+						                         MappingUtils::findMin(*grid,  A(f1, t1), A(f2, t2)));
+						assertEqual("Grid max.", MappingUtils::findMax(*multi, A(f1, t1), A(f2, t2)),
+						                         MappingUtils::findMax(*grid,  A(f1, t1), A(f2, t2)));
+					}
+				}
+			}
+		}
+
+		delete timed;
+		delete grid;
+		delete multi;
+	}
+
 	void testMappingUtils() {
 		testFindMinMax();
+		testTimeFreqGrid();
 	}
 
 	void runTests() {
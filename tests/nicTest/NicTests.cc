@@ -87,6 +87,16 @@ void NicTests::planTestRun5()
 	planTest("1", "Channel usage should be about same as run 2.");
 }
 
+void NicTests::planTestRun6()
+{
+	planTestModule("app0", "Host of pair A");
+	planTestModule("app1", "Sending Host of the aggregate");
+	planTestModule("app2", "Host of pair B");
+	planTestModule("app3", "Receiving Host of the aggregate on another channel");
+
+	planTest("1", "Every packet of a dropped aggregate is reported.");
+}
+
 void NicTests::testRun1(int stage, cMessage* /*msg*/)
 {
 	if(stage == 0) {
@@ -198,6 +208,13 @@ void NicTests::testRun5(int stage, cMessage* /*msg*/)
 	}
 }
 
+void NicTests::testRun6(int stage, cMessage* /*msg*/)
+{
+	if(stage == 0) {
+		getModule<TestApp>("app1")->testRun6(stage);
+	}
+}
+
 void NicTests::planTests(int run)
 {
 	//getModule<TestMacLayer>("mac0")->planTests(run);
@@ -212,6 +229,8 @@ void NicTests::planTests(int run)
     	planTestRun4();
     } else if(run == 5) {
     	planTestRun5();
+    } else if(run == 6) {
+    	planTestRun6();
     }
     else
     	assertFalse("Unknown test run number: " + run, true);
@@ -234,6 +253,9 @@ void NicTests::runTests(int run, int stage, cMessage* msg)
 	} else if(run == 5)
 	{
 		testRun5(stage, msg);
+	} else if(run == 6)
+	{
+		testRun6(stage, msg);
 	}
 	else
     	assertFalse("Unknown test run number: " + run, true);
@@ -254,7 +276,7 @@ void NicTests::testForRange(	std::string test,
 }
 
 void NicTests::onTestModuleMessage(std::string module, cMessage* msg){
-	if(run == 1)
+	if(run == 1 || run == 6)
 		return;
 
 	if(msg->getKind() >= TestApp::PING && msg->getKind() <= TestApp::PING+1000) {
@@ -108,6 +108,20 @@ protected:
 	 */
     void testRun5(int stage, cMessage* msg);
 
+    /**
+	 * @brief Plans tests to be executed in test run 6.
+	 */
+	void planTestRun6();
+	/**
+	 * @brief Executes test run 6 by forwarding execution to the correct
+	 * TestModule.
+	 *
+	 * Tests for this test run:
+	 * - every packet of an aggregate which reaches the retry limit is
+	 *   reported to the upper layer
+	 */
+    void testRun6(int stage, cMessage* msg);
+
     void onTestModuleMessage(std::string module, cMessage* msg);
 
     void testForRange(std::string test,
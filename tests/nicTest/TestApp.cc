@@ -182,6 +182,24 @@ void TestApp::testRun1(int stage)
 	}
 }
 
+void TestApp::testRun6(int stage)
+{
+	Enter_Method_Silent();
+
+	if(stage == 0) { //@app1
+		// app3 is on another channel, so the aggregate is never acknowledged
+		const LAddress::L2Type dest = manager->getModule<TestApp>("app3")->mac->getMACAddress();
+		for(int i = 0; i < 3; ++i) {
+			cPacket* p = new cPacket("Aggregated packet", AGGREGATED + i, 5000);
+			NetwToMacControlInfo::setControlInfo(p, dest);
+			send(p, out);
+		}
+		assertMessage(new AssertDroppedPacket("First packet dropped", AGGREGATED));
+		assertMessage(new AssertDroppedPacket("Second packet dropped", AGGREGATED + 1));
+		assertMessage(new AssertDroppedPacket("1", AGGREGATED + 2, true));
+	}
+}
+
 simtime_t TestApp::in(simtime_t delta) {
 	return simTime() + delta;
 }
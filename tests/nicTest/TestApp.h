@@ -22,6 +22,39 @@
 #include "Mac80211MultiChannel.h"
 #include "SimpleAddress.h"
 
+/**
+ * @brief Asserts a PACKET_DROPPED control message for the packet with the
+ * passed kind.
+ */
+class AssertDroppedPacket:public AssertMessage {
+protected:
+	int packetKind;
+public:
+	AssertDroppedPacket(std::string msg, int packetKind,
+						bool isPlanned = false):
+		AssertMessage(msg, isPlanned),
+		packetKind(packetKind)
+	{}
+
+	virtual ~AssertDroppedPacket() {}
+
+	/**
+	 * @brief Returns true if the passed message is a PACKET_DROPPED control
+	 * message which carries the expected packet.
+	 */
+	virtual bool isMessage(cMessage* msg) {
+		cPacket* frame = dynamic_cast<cPacket*>(msg);
+		return    msg->getKind() == BaseMacLayer::PACKET_DROPPED
+			   && frame && frame->getEncapsulatedPacket()
+			   && frame->getEncapsulatedPacket()->getKind() == packetKind;
+	}
+
+	virtual std::ostream& concat(std::ostream& o) const{
+		o << ": dropped packet kind = " << packetKind;
+		return o;
+	}
+};
+
 /**
  * @brief Executes most of the tests by sending packets to other instances of
  * this module.
@@ -69,10 +102,12 @@ protected:
 		TESTPACKET = 22331,
 		PONG = TESTPACKET + 10,
 		PING = PONG + 1,
+		AGGREGATED = TESTPACKET + 4, // one kind per packet of the aggregate
 
 	};
     int getCurrentChannel() const;
     void testRun1(int stage);
+    void testRun6(int stage);
     void startTraffic();
     void ping(int nr);
     void pong();
@@ -48,6 +48,7 @@ fi
 ./${lSingle} -c Test3 "${LIBSREF[@]}" >> out.tmp 2>> err.tmp
 ./${lSingle} -c Test4 "${LIBSREF[@]}" >> out.tmp 2>> err.tmp
 ./${lSingle} -c Test5 "${LIBSREF[@]}" >> out.tmp 2>> err.tmp
+./${lSingle} -c Test6 "${LIBSREF[@]}" >> out.tmp 2>> err.tmp
 
 [ x$lIsComb = x1 ] && rm -f ${lSingle} ${lSingle}.exe >/dev/null 2>&1
 cat out.tmp |grep -e "Passed" -e "FAILED" |\
@@ -0,0 +1,55 @@
+#!/bin/bash
+#
+# Compares the lifetimes of the periodically updated battery (host[0]) and
+# the event driven battery (host[1]) of each run; they have to differ by
+# less than the resolution of the run.
+
+iFailed=0
+iFileCnt=0
+
+resolution() {
+ case "$1" in
+  MidCycle|DeltaOnly) echo 0.1 ;;
+  Unaligned)          echo 0.1234 ;;
+  Coarse)             echo 0.5 ;;
+  *)                  echo 0 ;;
+ esac
+}
+
+for f in results/*.sca
+do
+ [ -f "$f" ] || continue
+ iFileCnt=$(( $iFileCnt + 1 ))
+ lConfig="$(awk '$1 == "attr" && $2 == "configname" { print $3 }' "$f")"
+ lRes="$(resolution "$lConfig")"
+ for lName in 'HostState::FAILED' 'lifetime'
+ do
+  lMsg="$(awk -v name="$lName" -v res="$lRes" '
+   $1 == "scalar" && $3 == name {
+    if ($2 ~ /\.host\[0\]\./) { periodic = $4; ++n }
+    if ($2 ~ /\.host\[1\]\./) { event    = $4; ++n }
+   }
+   END {
+    if (n != 2)
+     print "missing " name
+    else if (res <= 0)
+     print "unknown resolution"
+    else {
+     d = periodic - event
+     if (d < 0) d = -d
+     if (d >= res)
+      print name " periodic=" periodic " eventDriven=" event " resolution=" res
+    }
+   }' "$f")"
+  if [ -n "$lMsg" ]; then
+   echo "  FAILED $lConfig: $lMsg"
+   iFailed=$(( $iFailed + 1 ))
+  else
+   echo "  PASSED $lConfig $lName"
+  fi
+ done
+done
+
+[ $iFailed = 0 -a $iFileCnt != 0 ] && rm -rf results >/dev/null 2>&1
+[ $iFileCnt = 0 ] && iFailed=1
+exit $iFailed
@@ -50,6 +50,14 @@ if [ -d coord ]; then
     st=$?
     [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
 fi
+if [ -d baseUtils ]; then
+    ilCout=$(( $ilCout + 1 ))
+    echo '-----------------BaseUtils--------------------'
+    ( ( cd baseUtils >/dev/null 2>&1 && \
+    ./runTest.sh $1 ) && echo "PASSED" ) || ( echo "FAILED" && false )
+    st=$?
+    [ x$st = x0 ] || ilErrs=$(( $ilErrs + 1 ))
+fi
 if [ -d channelInfo ]; then
     ilCout=$(( $ilCout + 1 ))
     echo '----------------ChannelInfo-------------------'